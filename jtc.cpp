@@ -9,10 +9,13 @@
 #include <sstream>
 #include <deque>
 #include <set>
+#include <list>
 #include <climits>              // LONG_MAX
 #include <algorithm>
 #include <regex>
 #include <functional>
+#include <memory>
+#include <atomic>
 #include <unistd.h>             // STDOUT_FILENO - for term width, sysconf
 #include "lib/getoptions.hpp"
 #include "lib/Json.hpp"
@@ -53,18 +56,24 @@ using namespace std;
 // option definitions
 #define OPT_RDT -
 #define OPT_ALL a
+#define OPT_ASY b
 #define OPT_CMP c
+#define OPT_CPU C
 #define OPT_DBG d
 #define OPT_EXE e
+#define OPT_ECC E
 #define OPT_FRC f
 #define OPT_GDE g
 #define OPT_INS i
 #define OPT_JAL J
 #define OPT_JSN j
 #define OPT_LBL l
+#define OPT_SCL L
 #define OPT_MDF m
 #define OPT_SEQ n
+#define OPT_UNO o
 #define OPT_PRG p
+#define OPT_PAR P
 #define OPT_QUT q
 #define OPT_RAW r
 #define OPT_SWP s
@@ -73,6 +82,7 @@ using namespace std;
 #define OPT_UPD u
 #define OPT_WLK w
 #define OPT_CMN x
+#define OPT_IDX X
 #define OPT_PRT y
 #define OPT_SZE z
 
@@ -339,6 +349,16 @@ class GETopt: public Getopt {
                                           walk % x.factor == x.offset % x.factor;
                                        } );
                         };
+    size_t              walk_bound(void) {                      // # of walks -xn/n may process
+                         // i.e. when all -x select walks by their offsets (-x/N), walks past
+                         // the largest offset are never processed, otherwise it's unbounded
+                         size_t bound = 0;
+                         for(auto &x: wm_) {
+                          if(x.factor != 0 or x.offset == -1) return SIZE_T(-1);
+                          if(x.offset >= 0) bound = max(bound, SIZE_T(x.offset) + 1);
+                         }
+                         return wm_.empty()? SIZE_T(-1): bound;
+                        };
 
  private:
 
@@ -351,23 +371,298 @@ class GETopt: public Getopt {
 
 
 
+#define ASYNC_BLKSZ (64 * 1024)                                 // queued block size (-b)
+#define ASYNC_QMAX 16                                           // max number of queued blocks
+
+class AsyncOutbuf: public streambuf {
+ // a stream buffer relaying outputs to a background writer thread (facilitates -b):
+ // - outputs are accumulated in blocks and queued to the writer thread, which writes them into
+ //   the original (target) stream buffer, thus writing overlaps with walking/parsing
+ // - the queue is bounded (ASYNC_QMAX), when it's full the producer awaits the writer
+ // - sync() (i.e. flush) only hands over a pending block and does not await the writer,
+ //   all queued blocks are written out upon disengage()
+ // - once writing into the target fails (e.g. EPIPE, short write), remaining blocks are dropped
+ //   and all further outputs fail, so that the engaged stream gets badbit (as if unbuffered)
+ public:
+                        AsyncOutbuf(void) = default;
+                        AsyncOutbuf(const AsyncOutbuf &) = delete;
+                       ~AsyncOutbuf(void) { disengage(); }
+
+    void                engage(ostream &os);                    // relay os's outputs via thread
+    bool                disengage(void);                        // write out all, restore os
+
+ protected:
+    int                 overflow(int c) override;
+    streamsize          xsputn(const char *s, streamsize n) override;
+    int                 sync(void) override {
+                         if(not failed_ and not blk_.empty()) enqueue_();
+                         return failed_? -1: 0;
+                        }
+
+ private:
+    void                enqueue_(void);                         // queue a block being filled
+    void                writer_(void);                          // writer thread
+
+    ostream *           os_{nullptr};                           // engaged stream
+    streambuf *         tgt_{nullptr};                          // original (target) stream buffer
+    string              blk_;                                   // block being filled
+    deque<string>       queue_;                                 // filled blocks, await writing
+    mutex               mtx_;
+    condition_variable  cv_;
+    bool                done_{false};                           // no more blocks will come
+    atomic<bool>        failed_{false};                         // writing into target failed
+    thread              wt_;                                    // writer thread
+};
+
+
+
+void AsyncOutbuf::engage(ostream &os) {
+ // replace os's stream buffer and start the writer thread
+ os_ = &os;
+ tgt_ = os.rdbuf(this);
+ done_ = false;
+ failed_ = false;
+ wt_ = thread(&AsyncOutbuf::writer_, this);
+}
+
+
+
+bool AsyncOutbuf::disengage(void) {
+ // write out all queued blocks, stop the writer and reinstate original stream buffer;
+ // return false if writing has failed (the stream is then left with badbit set)
+ if(os_ == nullptr) return not failed_;
+ sync();
+ { ULOCK(mtx_) done_ = true; }
+ cv_.notify_all();
+ wt_.join();
+ os_->rdbuf(tgt_);                                              // (clears the stream's state)
+ if(failed_) os_->setstate(ios::badbit);
+ os_ = nullptr;
+ return not failed_;
+}
+
+
+
+int AsyncOutbuf::overflow(int c) {
+ // single char output
+ if(failed_) return traits_type::eof();
+ if(c == traits_type::eof()) return traits_type::not_eof(c);
+ blk_ += traits_type::to_char_type(c);
+ if(blk_.size() >= ASYNC_BLKSZ) enqueue_();
+ return c;
+}
+
+
+
+streamsize AsyncOutbuf::xsputn(const char *s, streamsize n) {
+ // bulk output
+ if(failed_) return 0;
+ blk_.append(s, n);
+ if(blk_.size() >= ASYNC_BLKSZ) enqueue_();
+ return n;
+}
+
+
+
+void AsyncOutbuf::enqueue_(void) {
+ // move the block into the queue (await the writer if the queue is full)
+ unique_lock<mutex> lck{mtx_};
+ cv_.wait(lck, [&]{ return queue_.size() < ASYNC_QMAX or failed_; });
+ if(failed_) { blk_.clear(); return; }                          // nowhere to write it
+ queue_.push_back(move(blk_));
+ blk_.clear();
+ lck.unlock();
+ cv_.notify_all();
+}
+
+
+
+void AsyncOutbuf::writer_(void) {
+ // write queued blocks in order, flush the target each time the queue runs empty; upon a
+ // failed (or short) write drop queued blocks and let the producer know
+ unique_lock<mutex> lck{mtx_};
+ while(true) {
+  cv_.wait(lck, [&]{ return done_ or not queue_.empty(); });
+  if(queue_.empty()) break;                                     // done_ and nothing left
+  string blk = move(queue_.front());
+  queue_.pop_front();
+  lck.unlock();
+  cv_.notify_all();                                             // let awaiting producer go
+  bool ok = tgt_->sputn(blk.data(), blk.size()) == SGNS_T(blk.size());
+  lck.lock();
+  if(ok and queue_.empty())
+   { lck.unlock(); ok = tgt_->pubsync() != -1; lck.lock(); }
+  if(not ok) {
+   failed_ = true;
+   queue_.clear();
+   cv_.notify_all();
+  }
+ }
+}
+
+#undef ASYNC_BLKSZ
+#undef ASYNC_QMAX
+
+
+
+
+
 class CommonResource {
  // the class facilitates -J option and global namespace:
  // caters user opt (which is copied to each Jtc instance), input string
  // and json for jsonization of all processed/walked jsons
 
-    struct JsonStore {
-     // facilitate JSON storage for concurrent reading/parsing
-                            JsonStore(void)
-                             { task_complete.lock(); }          // DC
-        deque<Json>         json_queue;                         // file may have multiple JSONs
-        mutex               task_complete;
-        bool                await_completion{true};
-      Streamstr::Filestatus file_status;
-        size_t              err_location;
+    #define JSQ_CAP 16                                          // JsonStore capacity (JSONs)
+    #define STG_CAP 4                                           // Pipe capacity (Interims)
+
+    class Event {
+     // await a condition / signal its change; mutex/cv pair is engaged only when awaited
+     public:
+        template<typename Cond>
+        void                await(Cond ready) {
+                             if(ready()) return;                // fast path, no locking
+                             unique_lock<mutex> lck{mtx_};
+                             ++awaited_;
+                             cv_.wait(lck, ready);
+                             --awaited_;
+                            }
+        void                signal(void)                        // the lock ensures the awaiting
+                             { if(awaited_.load() > 0)          // side is in wait() or ready()
+                                { { ULOCK(mtx_) } cv_.notify_all(); } }
+
+     private:
+        atomic<size_t>      awaited_{0};                        // number of awaiting threads
+        mutex               mtx_;
+        condition_variable  cv_;
+    };
+
+    struct JsqBudget {
+     // JSONs held by all JsonStores sharing the budget: bounds read-ahead across multiple files
+     // (otherwise each parsed file could hold up to JSQ_CAP JSONs until consumed)
+        atomic<size_t>      held{0};
+        size_t              cap{JSQ_CAP};
+        Event               pev;                                // producers' event (shared)
     };
 
+    class JsonStore {
+     // facilitate JSON handover from a thread parsing a file (producer) to the consumer: a
+     // bounded lock-free SPSC ring of JSONs, each JSON is released as soon as it's parsed; the
+     // producer awaits when the ring is full (backpressure), the consumer - when it's empty
+     // (consumer's event could be shared by multiple stores - to await any of them).
+     // Stores sharing a JsqBudget also await while the budget is exhausted, except the store
+     // being consumed (the priority one) - thus all the stores hold at most about budget's cap
+     // plus JSQ_CAP JSONs, regardless of the number of files
+     public:
+        void                push(Json && j) {                   // producer: hand over a JSON
+                             if(ring_.empty()) ring_.resize(JSQ_CAP);
+                             size_t t = tail_.load(memory_order_relaxed);
+                             pev_->await([&]{ return t - head_.load() < JSQ_CAP and
+                                                     (bgt_ == nullptr or prio_.load() or
+                                                      bgt_->held.load() < bgt_->cap); });
+                             if(bgt_ != nullptr) ++bgt_->held;
+                             ring_[t % JSQ_CAP] = move(j);
+                             tail_.store(t + 1);
+                             cev_->signal();
+                            }
+        void                close(void)                         // producer: no more JSONs
+                             { closed_.store(true); cev_->signal(); }
+
+        void                consumer_event(Event &e) { cev_ = &e; }    // before producer starts
+        void                budget(JsqBudget &b)                // before producer starts
+                             { bgt_ = &b; pev_ = &b.pev; }
+        void                prioritize(void)                    // consumer: exempt from budget
+                             { prio_.store(true); pev_->signal(); }
+        bool                is_ready(void)                      // consumer: front() won't block
+                             { return tail_.load() != head_.load() or closed_.load(); }
+        Json *              front(void) {                       // consumer: nullptr if no more
+                             cev_->await([&]{ return is_ready(); });
+                             size_t h = head_.load(memory_order_relaxed);
+                             if(tail_.load() != h) return &ring_[h % JSQ_CAP];
+                             vector<Json>().swap(ring_);        // drained: release the ring
+                             return nullptr;
+                            }
+        void                pop(void) {                         // consumer: release the front
+                             size_t h = head_.load(memory_order_relaxed);
+                             ring_[h % JSQ_CAP] = Json{};
+                             head_.store(h + 1);
+                             if(bgt_ != nullptr) --bgt_->held;
+                             pev_->signal();
+                            }
+        bool                is_drained(void)                    // consumer: closed and empty
+                             { return closed_.load() and tail_.load() == head_.load(); }
+
+        bool                await_completion{true};             // consumer: 1st time checking
+      Streamstr::Filestatus file_status;                        // set before 1st push/close
+        size_t              err_location;                       // set before failed JSON push
+
+     private:
+        vector<Json>        ring_;                              // allocated by the producer
+        atomic<size_t>      head_{0};                           // consumer's position
+        atomic<size_t>      tail_{0};                           // producer's position
+        atomic<bool>        closed_{false};
+        atomic<bool>        prio_{false};                       // being consumed (-> no budget)
+        JsqBudget *         bgt_{nullptr};                      // budget shared with other stores
+        Event               own_pev_;                           // producer's event (by default)
+        Event *             pev_{&own_pev_};                    // producer's event in use
+        Event               own_cev_;                           // consumer's event (by default)
+        Event *             cev_{&own_cev_};                    // consumer's event in use
+    };
+    #undef JSQ_CAP
+
  public:
+    struct Interim {
+     // a unit passed between pipelined option sets (stages): interim JSONs produced by a stage
+     // from a single input JSON, along with namespaces, rc and exception (if any raised)
+        Json                jsn{ARY{}};                         // interim JSONs
+        string              out;                                // console outputs
+        map_jnse            ns;                                 // global namespaces
+        int                 rc{RC_OK};                          // rc raised by prior stages
+        exception_ptr       ep;                                 // exception raised by a stage
+        size_t              el{SIZE_T(-1)};                     // ep's parsing location (if any)
+    };
+
+    class Pipe {
+     // bounded SPSC queue of Interims between adjacent stages; the producer awaits when the pipe
+     // is full, the consumer - when it's empty; the consumer may cancel the pipe (once it fails),
+     // then the producer's push() returns false
+     public:
+        bool                push(Interim && x) {                // producer: false if cancelled
+                             size_t t = tail_.load(memory_order_relaxed);
+                             pev_.await([&]
+                              { return t - head_.load() < STG_CAP or cancelled_.load(); });
+                             if(cancelled_.load()) return false;
+                             ring_[t % STG_CAP] = move(x);
+                             tail_.store(t + 1);
+                             cev_.signal();
+                             return true;
+                            }
+        void                close(void)                         // producer: no more Interims
+                             { closed_.store(true); cev_.signal(); }
+        bool                pop(Interim & x) {                  // consumer: false if no more
+                             cev_.await([&]
+                              { return tail_.load() != head_.load() or closed_.load(); });
+                             size_t h = head_.load(memory_order_relaxed);
+                             if(tail_.load() == h) return false;
+                             x = move(ring_[h % STG_CAP]);
+                             head_.store(h + 1);
+                             pev_.signal();
+                             return true;
+                            }
+        void                cancel(void)                        // consumer: stop the producer
+                             { cancelled_.store(true); pev_.signal(); }
+        bool                is_cancelled(void) const { return cancelled_.load(); }
+
+     private:
+        Interim             ring_[STG_CAP];
+        atomic<size_t>      head_{0};                           // consumer's position
+        atomic<size_t>      tail_{0};                           // producer's position
+        atomic<bool>        closed_{false};
+        atomic<bool>        cancelled_{false};
+        Event               pev_;                               // producer's event
+        Event               cev_;                               // consumer's event
+    };
+    #undef STG_CAP
+
 
     int                 rc(void) const { return rc_; }
     void                rc(int rc) { rc_ = rc; }
@@ -382,6 +677,7 @@ class CommonResource {
     void                elocation(size_t x) { elocation_ = x; }
 
     void                decompose_opt(int argc, char *argv[]);
+    bool                is_re_captured(void) const { return re_captures_; }
     void                display_opts(std::ostream & out);
     bool                is_decomposed_front(void) { return opp_ == &vopt_.front(); }
     bool                is_decomposed_back(void) { return opp_ == &vopt_.back(); }
@@ -406,10 +702,24 @@ class CommonResource {
     auto &              wm(void) { return wm_; }
 
     ThreadMaster &      tm(void) { return tm_; }
+    void                decide_on_cpu_limits(void);
     void                decide_on_multithreaded_parsing(void);
+    void                decide_on_streamed_global_output(void);
+    void                decide_on_parallel_processing(void);
+    bool                is_parallel(void) const { return parallel_; }
+    ThreadMaster &      ptm(void) { return ptm_; }
+    void                decide_on_pipelining(void);
+    bool                is_pipelined(void) const { return pipelined_; }
+    ThreadMaster &      stm(void) { return stm_; }
+    void                decide_on_shell_concurrency(void);
+    void                check_search_cache_limits(void);
+    ThreadMaster &      xtm(void) { return xtm_; }
+    bool                close_streamed_global_output(void);
     deque<JsonStore> &  json_store(void) { return jsd_; };
-    size_t              jsq_idx(void) const { return jsq_idx_; };
-    void                jsq_idx(size_t x) { jsq_idx_ = x; };
+    size_t              next_jsq(void);                         // JsonStore to consume from
+    void                jsq_drained(size_t idx);                // JsonStore[idx] is consumed
+    bool                is_last_jsq(size_t idx)                 // no other JsonStore pending
+                         { return unordered_? jsq_pend_.size() == 1: idx == jsd_.size() - 1; }
 
  private:
     bool                is_recompile_required_(const v_string & args);
@@ -417,11 +727,15 @@ class CommonResource {
     void                parse_arguments_(const v_string & new_args);
     void                convert_xyw_(void);
     bool                is_x_factor_(const char *str, signed_size_t * recursive = nullptr);
+    bool                parse_cpus_(const char *str, vector<size_t> & cpus);
 
     void                fetch_dispatcher_(void);
     void                read_and_parse_json_(const string & fn, JsonStore & js);
+    void                read_and_parse_stream_(JsonStore & js);
 
     Json                gjsn_{ ARY{} };                         // global json (facilitates -J)
+    bool                stream_gjsn_{false};                    // -J output is streamed
+    Jwriter             gjwr_{cout};                            // writer for streamed -J output
     map_jnse            gns_;                                   // global namespaces
     bool                read_from_cin_{false};                  // read from <cin>? or files
     Streamstr           iss_;                                   // input Streamstr
@@ -432,10 +746,21 @@ class CommonResource {
                         wm_;                                    // walk factor: facilitate -xN/M
     int                 rc_{RC_OK};
     size_t              elocation_{SIZE_T(-1)};                 // exception location
+    bool                re_captures_{true};                     // RE captures could be referred
 
     ThreadMaster        tm_;                                    // thread manager
     deque<JsonStore>    jsd_;                                   // JsonStore dequeue
     size_t              jsq_idx_{0};                            // index into jsd_ store
+    bool                unordered_{false};                      // -o: consume jsd_ as ready
+    list<size_t>        jsq_pend_;                              // -o: pending JsonStores indices
+    Event               jsq_ev_;                                // -o: awaiting any JsonStore
+    JsqBudget           jsq_bgt_;                               // JSONs read ahead by all stores
+    bool                parallel_{false};                       // -P: JSONs processed in parallel
+    ThreadMaster        ptm_;                                   // processing pool (-P, -w walks)
+    bool                pipelined_{false};                      // option sets run as a pipeline
+    ThreadMaster        stm_;                                   // pipeline stages pool
+    ThreadMaster        xtm_;                                   // shell cli pool (-ee)
+    size_t              cpul_{0};                               // -C N: threads per pool limit
 
  public:
     DEBUGGABLE(iss_, gjsn_, tm_)
@@ -493,6 +818,31 @@ class Jtc {
     };
 
 
+    struct Pctx {
+     // private context of a Jtc processing its JSON in a worker thread (-P): resources shared
+     // via CommonResource are substituted with the copies below, those are committed back
+     // by the main thread in the order of input JSONs (see commit_parallel())
+        GETopt              opt;                                // copy of the user options
+        map_jnse            gns;                                // snapshot of global namespaces
+        vector<Json>        gjsn;                               // jsonized outputs (-J)
+        ostringstream       out;                                // console outputs
+        int                 rc{RC_OK};                          // rc raised while processing
+    };
+
+
+    struct WalkFeed {
+     // lazily walked -w path(s) feeding a queue of interleaved walks (in wpi), with -n a single
+     // feed walks all -w paths one after another (see walk_interleaved_)
+        size_t              next;                               // next -w to begin walking
+        size_t              end;                                // past the last -w of the feed
+        bool                lazy;                               // walk one instance ahead only
+        bool                walking{false};                     // a -w is being walked
+        Json::iterator *    last{nullptr};                      // latest walked instance
+        map_jnse *          lns{nullptr};                       // its NS, once consumed (lazy)
+        deque<map_jnse>     ens;                                // NS left by empty walks after
+    };
+
+
     struct ShellReturn {
      // keeping return result from running shell commands: string and return codes values
             string          str;
@@ -530,7 +880,10 @@ class Jtc {
 
  public:
                         Jtc(void) = delete;
-                        Jtc(CommonResource & cr): cr_{cr} {
+                        Jtc(CommonResource & cr): Jtc(cr, false) {}
+                        Jtc(CommonResource & cr, bool parallel, // parallel: run in a worker
+                            signed_size_t set = -1):            // set: option set to copy
+                         cr_{cr}, pctx_{parallel? new Pctx{cr.opt(set)}: nullptr} {
                          ecli_ = opt()[CHR(OPT_EXE)].hits() == 0?
                                   Ecli::No_exec: opt()[CHR(OPT_EXE)].hits() == 1?
                                                   Ecli::Bulk_exec: Ecli::Per_walk_exec;
@@ -550,10 +903,12 @@ class Jtc {
                               .quote_solidus(opt()[CHR(OPT_QUT)].hits() % 2 == 1);
                          jinp_.callback(GLAMBDA(shell_callback_)).engage_callbacks();
                         }
+                       ~Jtc(void) { jout_wr_.flush(); }         // pass all buffered outputs
 
 
     // expose private objects
-    GETopt &            opt(signed_size_t x = -1) { return cr_.opt(x); }
+    GETopt &            opt(signed_size_t x = -1)
+                         { return pctx_ and x < 0? pctx_->opt: cr_.opt(x); }
     auto &              json(void) { return jinp_; }
     auto &              jout(void) { return jout_; }
 
@@ -575,6 +930,11 @@ class Jtc {
     void                output_by_iterator(Json::iterator &wi, Grouping = {0, 0});
     map_jnse &          last_wns_snapshot(void) { return wns_[last_dwi_ptr_]; }
     vec_bjit &          itr_pairs(void) { return psrc_; }
+    map_jnse &          parallel_ns(void) { return pctx_->gns; }
+    void                commit_parallel(void);
+    void                commit_pipelined(CommonResource::Interim & itm);
+    string              parallel_out(void)                      // console outputs (so far)
+                         { jout_wr_.flush(); return pctx_->out.str(); }
 
  private:
     void                display_location_(Streamstr::const_iterator & start);
@@ -592,6 +952,8 @@ class Jtc {
     void                merge_into_array_(Jnode &dst, const Jnode &src, MergeObj mode);
     void                update_jsons_(Json::iterator &dst, Json::iterator src, string *lbl);
     vector<ShellReturn> run_bulk_shell_(void);
+    vector<future<ShellReturn>>
+                        run_concurrent_shell_(void);
     bool                execute_cli_(Json &update, Json::iterator &jit,
                                      Json::map_jne &ns, ShellReturn *);
     string              interpolate_shell_str_(Json::iterator &jit, Json::map_jne &ns);
@@ -599,10 +961,20 @@ class Jtc {
     bool                remove_others_(set<const Jnode*> &ws, Jnode &jn);
     vec_jit             collect_walks_(const string &walk_path);
     void                walk_interleaved_(wlk_subscr Jtc::* subscriber);
-    void                process_walk_iterators_(deque<deq_jit> &walk_iterators);
-    size_t              build_front_grid_(vector<vector<signed_size_t>> &, const deque<deq_jit> &);
-    void                process_offsets_(deque<deq_jit> &, vector<vector<signed_size_t>> &,
-                                         size_t, vector<size_t> &);
+    bool                is_walk_concurrent_(wlk_subscr Jtc::* subscriber);
+    size_t              walk_bound_(void);
+    void                walk_concurrently_(deque<deq_jit> &walk_iterators);
+    size_t              expand_walk_(Json &ctx, const string &walk_path,
+                                     deq_jit &dwi, deque<map_jnse> &dns);
+    void                advance_walk_(deque<deq_jit> &walk_iterators,
+                                      vector<WalkFeed> &feeds, size_t idx);
+    void                end_walk_(vector<WalkFeed> &feeds, size_t idx);
+    void                retire_walk_ns_(Json::iterator &wi, WalkFeed &feed);
+    void                process_walk_iterators_(deque<deq_jit> &walk_iterators,
+                                                vector<WalkFeed> &feeds);
+    void                build_front_row_(vector<signed_size_t> &, const deq_jit &, size_t);
+    Grouping            process_offsets_(vector<vector<signed_size_t>> &, size_t,
+                                         vector<size_t> &);
     void                console_output_(Json::iterator &, Json &jref, Grouping unused);
     void                jsonized_output_(Json::iterator &, Json &jref, Grouping unused);
     void                jsonized_output_obj_(Json::iterator &, Json &jref, Grouping);
@@ -626,12 +998,17 @@ class Jtc {
                          }
                          return 0;                              // covering linux compiler warning
                         }
+    map_jnse &          global_ns_(void)
+                         { return pctx_? pctx_->gns: cr_.global_ns(); }
+    void                rc_(int rc)
+                         { if(pctx_) pctx_->rc = rc; else cr_.rc(rc); }
     size_t              walk_options_start_idx_(void) const
                          // return starting idx for the given type of a source
                          { return jsrt_ == Src_optarg? 0: 1; }
 
     // private member types:
     CommonResource &    cr_;
+    unique_ptr<Pctx>    pctx_;                                  // context of a parallel run
 
     Json                jout_;                                  // json output (-j, -jj)
     Json                jinp_;                                  // input JSON for jtc
@@ -645,6 +1022,8 @@ class Jtc {
     map<Json::iterator*, map_jnse>
                         wns_;                                   // namespaces for walked (-w) paths
     map_jnse            ins_;                                   // holds interleaved namespaces
+    deque<map_jnse>     rns_;                                   // NS of consumed walks, referred
+    deque<Json>         wctx_;                                  // contexts of concurrent walks
     Json::iterator *    last_dwi_ptr_{nullptr};
     Jnode               hwlk_{ARY{STR{}}};                      // last walked value (interpolated)
 
@@ -653,6 +1032,7 @@ class Jtc {
     bool                is_tpw_;                                // templates pertain to walks
     bool                is_multi_walk_{false};                  // multiple -w or single iterable?
     bool                convert_req_{false};                    // used in output_by_iterator
+    bool                stream_ary_{false};                     // -j elements streamed, no jout_
     Ecli                ecli_{Ecli::No_exec};                   // -e status for insert/update
     bool                merge_{false};                          // -m status for insert/update
     bool                lbl_update_{false};                     // label update operation detected
@@ -660,6 +1040,8 @@ class Jtc {
     size_t              key_{0};                                // general purpose counter
     size_t              upst_key_{0};                           // template idx for -iu round-robin
     size_t              wcnt_{0};                               // counts number of walks
+    size_t              wlim_{SIZE_T(-1)};                      // walks past it aren't output
+    bool                wlast_{true};                           // subscribed walk is the last one
     wlk_subscr Jtc::*   subscriber_;                            // method ptr for output processor
     Shell               sh_;
     long                arg_max_{-1};                           // shell's ARG_MAX
@@ -673,9 +1055,15 @@ class Jtc {
     bool                glean_lbls_{opt()[CHR(OPT_LBL)].hits()>=2}; // facilitate -ll
     bool                size_only_{opt()[CHR(OPT_SZE)].hits() > 1}; // facilitate -zz
     bool                use_hpfx_{opt().imposed(USE_HPFX)};         // facilitate '$?' or -x0/-1
+    bool                tmp_hpfx_                                   // {$?} is in templates
+                         {any_of(opt()[CHR(OPT_TMP)].begin(), opt()[CHR(OPT_TMP)].end(),
+                                 [](const string &t)
+                                  { return t.find("{" WLK_HPFX "}") != string::npos; })};
     ofstream            fout_                                       // open file handler if needed
                          {write_to_file_? cr_.iss().filename().c_str(): "", Jtc::mod_};
-    ostream &           xout_{write_to_file_? fout_: cout};         // demux cout/file outputs
+    ostream &           xout_                                       // demux cout/file outputs
+                         {write_to_file_? fout_: pctx_? pctx_->out: cout};
+    Jwriter             jout_wr_{xout_};                            // buffered writer into xout_
 
     static ios_base::openmode
                         mod_;                                       // write to file (1st json)
@@ -695,6 +1083,12 @@ ios_base::openmode  Jtc::mod_{ios_base::out};                   // write to file
 // list of standalone calls
 void run_decomposed_optsets(CommonResource &, Streamstr::const_iterator &);
 void run_single_optset(CommonResource &, Streamstr::const_iterator &, Json &in, Json &out);
+void run_parallel_optset(CommonResource &, Streamstr::const_iterator &);
+void run_pipelined_optsets(CommonResource &, Streamstr::const_iterator &);
+void run_pipeline_stage(CommonResource &, size_t set, CommonResource::Pipe &in,
+                        CommonResource::Pipe *out);
+void run_pipelined_optset(CommonResource &, size_t set, CommonResource::Interim &itm);
+void reduce_streamed_global_output(CommonResource &);
 string sh_quote_str(const string &src);
 
 
@@ -711,13 +1105,20 @@ int main(int argc, char *argv[]) {
             "), developed by " CREATOR " (" EMAIL ")\n");
  opt[CHR(OPT_ALL)].desc("process all JSONs from source, or disable multithreading if multiple"
                         " sources given");
+ opt[CHR(OPT_ASY)].desc("write outputs to stdout asynchronously: in a background thread, "
+                        "overlapping with walking and parsing");
  opt[CHR(OPT_CMN)].desc("a common part of a walk-path, prepended to every followed -" STR(OPT_PRT)
                         " option").name("common_wp");
  opt[CHR(OPT_CMP)].desc("compare with JSON (given as JSON/walk/template): display delta between"
                         " given JSONs").name("j|w|t");
+ opt[CHR(OPT_CPU)].desc("limit worker threads (per pool) to N, optionally pin them to given cpus,"
+                        " e.g.: -" STR(OPT_CPU) "4:0-1,8-9").name("N[:cpus]");
  opt[CHR(OPT_DBG)].desc("turn on debugs (multiple calls increase verbosity)");
  opt[CHR(OPT_EXE)].desc("make option parameters for -" STR(OPT_INS) "/-" STR(OPT_UPD)
                         " undergo a shell evaluation; see -" STR(OPT_GDE) " for more info");
+ opt[CHR(OPT_ECC)].desc("run up to N shell cli concurrently with -" STR(OPT_EXE) STR(OPT_EXE)
+                        " (0: as many as worker threads); by default cli run one by one")
+                  .name("N");
  opt[CHR(OPT_FRC)].desc("apply changes into the file argument instead of printing resulting JSON"
                         " to stdout");
  opt[CHR(OPT_GDE)].desc("mini USER-GUIDE: explain walk path syntax, usage notes, some examples");
@@ -725,15 +1126,22 @@ int main(int argc, char *argv[]) {
                          "' enforces semi-compact format)").bind("3").name("indent");
  opt[CHR(OPT_INS)].desc("insert JSON (given as JSON/walk/template); see with -" STR(OPT_GDE)
                         " for more").name("j|w|t");
+ opt[CHR(OPT_IDX)].desc("index labels and values of the input JSON for recursive label and exact"
+                        " value searches (speeds up many different searches over a big JSON)");
  opt[CHR(OPT_JAL)].desc("wrap all processed JSONs into an array (option -"
                         STR(OPT_ALL) " assumed, buffered read imposed)");
  opt[CHR(OPT_JSN)].desc("wrap all walked elements from one JSON into a JSON array (-"
                         STR(OPT_JSN) STR(OPT_JSN) " wrap into an object)");
  opt[CHR(OPT_LBL)].desc("print labels (if present) for walked JSONs; together with -"
                         STR(OPT_JSN) " wrap into objects");
+ opt[CHR(OPT_SCL)].desc("limit (estimated) search caches of a JSON to N MB, least recently used"
+                        " caches are evicted (0: unlimited, the default)")
+                  .name("N");
  opt[CHR(OPT_MDF)].desc("modifier: toggle merging for options -" STR(OPT_INS) ", -" STR(OPT_UPD)
                         ", -" STR(OPT_JSN) STR(OPT_JSN) "; see with -" STR(OPT_GDE)
                         " for more info");
+ opt[CHR(OPT_PAR)].desc("process JSONs in parallel worker threads, outputs kept in the order of"
+                        " input JSONs (namespaces are not shared between JSONs)");
  opt[CHR(OPT_PRG)].desc("purge all walked JSON elements (-" STR(OPT_PRG) STR(OPT_PRG)
                         ": purge all elements except ones walked)");
  opt[CHR(OPT_PRT)].desc("an individual part of a walk-path, prepended by preceding -" STR(OPT_CMN)
@@ -750,6 +1158,8 @@ int main(int argc, char *argv[]) {
  opt[CHR(OPT_TMP)].desc("a template to interpolate and apply upon -" STR(OPT_INS) "/"
                         STR(OPT_UPD) "/" STR(OPT_CMP) " and standalone -"
                         STR(OPT_WLK) " operations").name("template");
+ opt[CHR(OPT_UNO)].desc("process JSONs from multiple files in the order they get parsed (rather"
+                        " than in the order of files)");
  opt[CHR(OPT_UPD)].desc("update with JSON (given as either JSON/walk/template); see with -"
                         STR(OPT_GDE) " for more").name("j|w|t");
  opt[CHR(OPT_WLK)].desc("a standalone walk path (multiple may be given); see with -"
@@ -801,9 +1211,24 @@ for a complete user guide visit https://github.com/ldn-softdev/jtc/blob/master/U
  ios_base::sync_with_stdio(false);                              // speedup cout & cin
  cin.tie(nullptr);
 
+ static AsyncOutbuf aob;                                        // static: for atexit() below
+ for(size_t i = 0; i < cr.total_decomposed(); ++i)
+  if(cr.opt(i)[CHR(OPT_ASY)].hits() > 0) {                      // -b given in any option set
+   aob.engage(cout);
+   atexit([]{ aob.disengage(); });                              // drain outputs upon any exit()
+   break;
+  }
+
  // decide if multithreaded parsing to be engaged
+ cr.decide_on_cpu_limits();
+ cr.decide_on_shell_concurrency();
+ cr.check_search_cache_limits();
  cr.init_inputs();
  cr.decide_on_multithreaded_parsing();
+ cr.decide_on_streamed_global_output();
+ cr.decide_on_parallel_processing();
+ cr.decide_on_pipelining();
+ Json::search_pool(&cr.ptm());                                  // let recursive searches split
 
  // ready to read json (ready stream buffer, produce iterator)
  Streamstr::const_iterator jsp = cr.iss().begin();              // global parse pointer
@@ -840,13 +1265,19 @@ for a complete user guide visit https://github.com/ldn-softdev/jtc/blob/master/U
   cr.rc(e.code() + OFF_REGEX);
  }
 
- if(cr.global_json().is_empty()) exit(cr.rc());
+ if(cr.close_streamed_global_output())                          // -J was already streamed
+  { aob.disengage(); exit(cr.rc()); }
+ if(cr.global_json().is_empty())
+  { aob.disengage(); exit(cr.rc()); }
 
- Jtc jtc(cr.decomposed_back());                                 // need for access to write_json()
- for(const char *o = STR(OPT_JAL) STR(OPT_JSN) STR(OPT_QUT) STR(OPT_RAW); *o != CHR_NULL; ++o)
-  jtc.opt()[*o].reset();                                        // above options to be ignored
- jtc.write_json(cr.global_json());
+ {                                                              // scoped: let jtc drain outputs
+  Jtc jtc(cr.decomposed_back());                                // need for access to write_json()
+  for(const char *o = STR(OPT_JAL) STR(OPT_JSN) STR(OPT_QUT) STR(OPT_RAW); *o != CHR_NULL; ++o)
+   jtc.opt()[*o].reset();                                       // above options to be ignored
+  jtc.write_json(cr.global_json());
+ }
 
+ aob.disengage();                                               // join the writer, flush outputs
  exit(cr.rc());
 }
 
@@ -857,6 +1288,8 @@ void run_decomposed_optsets(CommonResource &cr, Streamstr::const_iterator &jsp)
  #include "lib/dbgflow.hpp"
  // run demux_opt for all decomposed options (in vopt_)
 
+ if(cr.is_pipelined()) return run_pipelined_optsets(cr, jsp);    // option sets run concurrently
+
  Json itrmi, itrmo;                                               // interim input/output
  if(DBG()(0)) { itrmi.DBG().severity(NDBG); itrmo.DBG().severity(NDBG); }
  cr.global_ns().clear();
@@ -866,15 +1299,7 @@ void run_decomposed_optsets(CommonResource &cr, Streamstr::const_iterator &jsp)
   DBG(1) DOUT() << "pass for set[" << cr.decomposed_idx() << "]" << endl;
   itrmo = ARY();                                                 // output store
 
-  // in a streamed cin option processing of -J is reduced to -j - because of a difference in
-  // the was streamed cin processed vs other modes.
-  if(jsp.is_streamed() and cr.opt()[CHR(OPT_JAL)].hits() > 0) {
-   cr.disable_global_output();
-   cr.opt()[CHR(OPT_JAL)].reset();
-   if(cr.opt()[CHR(OPT_JSN)].hits() == 0) cr.opt()[CHR(OPT_JSN)].hit();
-   cerr << "notice: in " << STRENM(Streamstr::Strmod, Streamstr::Strmod::streamed_cin)
-        << " mode, behavior of option -" STR(OPT_JAL) " is reduced to -" STR(OPT_JSN) << endl;
-  }
+  if(jsp.is_streamed()) reduce_streamed_global_output(cr);
   GUARD(cr.opt())
 
   // the output of demux_opt() could be multiple JSONs (to the console) or single json (to gjsn_),
@@ -887,7 +1312,8 @@ void run_decomposed_optsets(CommonResource &cr, Streamstr::const_iterator &jsp)
   }
 
   // process all jsons either from <input>, or from interim (itrmi)
-  run_single_optset(cr, jsp, itrmi, itrmo);
+  if(cr.is_parallel()) run_parallel_optset(cr, jsp);            // only a single option set
+  else run_single_optset(cr, jsp, itrmi, itrmo);
 
   itrmi = move(itrmo);
   cr.next_decomposed();                                         // point opt() to the next set
@@ -933,6 +1359,165 @@ void run_single_optset(CommonResource &cr,
 
 
 
+void run_parallel_optset(CommonResource &cr, Streamstr::const_iterator &jsp) {
+ // process all jsons of a single option set in parallel (-P): the main thread parses jsons and
+ // hands each one (in own Jtc) over to the worker pool; results are committed strictly in the
+ // order of input jsons through a bounded reorder window. Each json starts off with the global
+ // namespace as it was before the first json, own namespace is merged into it when committed
+ typedef pair<unique_ptr<Jtc>, future<void>> jtc_task;
+ deque<jtc_task> window;                                        // reorder window
+ size_t max_window = 2 * cr.ptm().seats_total();                // bounds # of held jsons
+ map_jnse gns{cr.global_ns()};                                  // initial global namespace
+
+ auto commit_front = [&window] {
+                      jtc_task t{move(window.front())};         // finished task leaves window
+                      window.pop_front();                       // first, even if it failed
+                      t.second.get();                           // rethrows Jtc's exception
+                      t.first->commit_parallel();
+                     };
+ try {
+  while(true) {
+   while(not window.empty() and                                 // commit completed in order
+         window.front().second.wait_for(chrono::seconds(0)) == future_status::ready)
+    commit_front();
+   if(window.size() >= max_window) { commit_front(); continue; }
+
+   unique_ptr<Jtc> jtc{new Jtc(cr, true)};
+   auto pse = jsp;
+   bool parsed;
+   try { parsed = jtc->parsejson(jsp, pse); }
+   catch(...) {                                                 // prior jsons go first, their
+    size_t el = cr.elocation();                                 // exceptions are not parsing
+    cr.elocation(SIZE_T(-1));                                   // ones
+    while(not window.empty()) commit_front();
+    cr.elocation(el);
+    throw;
+   }
+   if(not parsed) break;
+
+   jtc->parallel_ns() = gns;
+   jtc->parallel_ns()[FILE_NSP] = cr.global_ns()[FILE_NSP];
+   Jtc * jp = jtc.get();
+   window.emplace_back(move(jtc), cr.ptm().submit([jp]{ jp->demux_opt(); }));
+  }
+  while(not window.empty()) commit_front();
+ }
+ catch(...) {                                                   // running Jtcs must finish
+  for(auto &t: window) t.second.wait();                         // before they are destroyed
+  throw;
+ }
+}
+
+
+
+void reduce_streamed_global_output(CommonResource &cr) {
+ // in a streamed cin option processing of -J is reduced to -j - because of a difference in
+ // the was streamed cin processed vs other modes.
+ if(cr.opt()[CHR(OPT_JAL)].hits() == 0) return;
+ cr.disable_global_output();
+ cr.opt()[CHR(OPT_JAL)].reset();
+ if(cr.opt()[CHR(OPT_JSN)].hits() == 0) cr.opt()[CHR(OPT_JSN)].hit();
+ cerr << "notice: in " << STRENM(Streamstr::Strmod, Streamstr::Strmod::streamed_cin)
+      << " mode, behavior of option -" STR(OPT_JAL) " is reduced to -" STR(OPT_JSN) << endl;
+}
+
+
+
+void run_pipelined_optsets(CommonResource &cr, Streamstr::const_iterator &jsp) {
+ // streamed cin with chained option sets: each option set runs as a pipeline stage - the first
+ // one in the main thread (reading input JSONs), each other one in a thread of own; interim
+ // JSONs of every input JSON flow stage by stage through bounded pipes, the last stage outputs
+ // results. An input JSON is processed by each stage the same way as in run_decomposed_optsets.
+ // The 1st stage reads ahead of later stages by up to the pipes' capacity (like the parsing
+ // thread does) and stops reading input once any later stage fails
+ size_t stages = cr.total_decomposed();
+ for(size_t i = 0; i < stages; ++i, cr.next_decomposed()) {     // ready all option sets once
+  reduce_streamed_global_output(cr);
+  if(not cr.is_decomposed_back() and cr.opt()[CHR(OPT_JAL)].hits() == 0)
+   { cr.enable_global_output(); cr.opt().impose(CHR(OPT_JAL)); }   // interim output is -J
+ }
+
+ deque<CommonResource::Pipe> pipe(stages - 1);                  // pipe[i]: stage i -> i+1
+ vector<future<void>> fut;
+ for(size_t i = 1; i < stages; ++i)
+  fut.push_back(cr.stm().submit(run_pipeline_stage, ref(cr), i, ref(pipe[i - 1]),
+                                i + 1 < stages? &pipe[i]: nullptr));
+ while(not pipe.front().is_cancelled()) {                      // 1st stage
+  CommonResource::Interim itm;
+  try {
+   cr.global_ns().clear();
+   Jtc jtc(cr, true, 0);
+   auto pse = jsp;
+   if(jtc.parsejson(jsp, pse) == false) break;                  // nothing left
+   jtc.parallel_ns() = cr.global_ns();
+   try { jtc.demux_opt(); }
+   catch(...) { itm.out += jtc.parallel_out(); throw; }         // outputs prior the exception
+   jtc.commit_pipelined(itm);
+  }
+  catch(...) {                                                  // parsing location goes along,
+   itm.ep = current_exception();                                // an exception of a prior input
+   itm.el = cr.elocation();                                     // JSON might get rethrown first
+   cr.elocation(SIZE_T(-1));
+  }
+  bool failed = itm.ep != nullptr;
+  if(not pipe.front().push(move(itm)) or failed) break;         // a later stage failed, or this
+ }
+ pipe.front().close();
+
+ for(auto &f: fut) f.wait();                                    // stages refer to pipes
+ fut.back().get();                                              // the last stage rethrows
+}
+
+
+
+void run_pipeline_stage(CommonResource &cr, size_t set,
+                        CommonResource::Pipe &in, CommonResource::Pipe *out) {
+ // process Interims from the prior stage and pass results on to the next stage (out), or
+ // output them (out == nullptr - the last stage); an exception raised by any stage is passed
+ // down to the last stage, which rethrows it (i.e. after outputs of all prior input JSONs)
+ CommonResource::Interim itm;
+ while(in.pop(itm)) {
+  if(itm.ep == nullptr)
+   try { run_pipelined_optset(cr, set, itm); }
+   catch(...) { itm.ep = current_exception(); }
+  bool failed = itm.ep != nullptr;
+  if(out == nullptr) {                                          // last stage
+   cout << itm.out << flush;
+   itm.out.clear();
+   if(itm.rc != RC_OK) cr.rc(itm.rc);
+   if(failed) {
+    in.cancel();
+    if(itm.el != SIZE_T(-1)) cr.elocation(itm.el);              // 1st stage is done by now
+    rethrow_exception(itm.ep);
+   }
+   continue;
+  }
+  if(not out->push(move(itm)) or failed) { in.cancel(); break; }
+ }
+ if(out) out->close();
+}
+
+
+
+void run_pipelined_optset(CommonResource &cr, size_t set, CommonResource::Interim &itm) {
+ // process interim JSONs of a single input JSON by the option set (like run_single_optset)
+ Json itrmi{move(itm.jsn)};
+ itm.jsn = ARY{};
+ for(auto &jn: itrmi) {
+  Jtc jtc(cr, true, set);
+  jtc.json().root() = move(jn);
+  jtc.parallel_ns() = move(itm.ns);
+  try { jtc.demux_opt(); }
+  catch(...) { itm.out += jtc.parallel_out(); throw; }          // outputs prior the exception
+  jtc.commit_pipelined(itm);
+  if(not ((jtc.opt()[CHR(OPT_ALL)].hits() > 0 and not jtc.opt().imposed(CHR(OPT_ALL))) or
+          (jtc.opt()[CHR(OPT_JAL)].hits() > 0 and not jtc.opt().imposed(CHR(OPT_JAL)))))
+   break;                                                       // neither -a, nor -J given
+ }
+}
+
+
+
 //
 // CR PUBLIC methods definitions
 //
@@ -945,6 +1530,9 @@ void CommonResource::decompose_opt(int argc, char *argv[]) {
  // decompose options by delimiter '/' and then parse each option separately
  v_string args{argv, argv + argc};
  v_string newargs;
+ re_captures_ = any_of(args.begin() + 1, args.end(),            // RE captures ($0..$n, $@) are
+                       [](const string &arg)                    // referred only by interpolation
+                        { return arg.find_first_of("{$") != string::npos; });  // or ns lexemes
 
  do {
   newargs.clear();
@@ -1146,6 +1734,15 @@ void CommonResource::init_inputs(void) {
 void CommonResource::jsonize(Json jout) {
  #include "lib/dbgflow.hpp"
  // put all walked json results into a global json
+ if(stream_gjsn_ and is_decomposed_back()) {                    // write elements right away
+  if(opt().imposed(CHR(OPT_JSN)) and jout.is_iterable())
+   for(auto &jn: jout) gjwr_.array_element(jn);
+  else
+   gjwr_.array_element(jout.root());
+  gjwr_.drain();                                                // keep outputs order with Jtc's
+  return;
+ }
+
  if(opt().imposed(CHR(OPT_JSN)) and jout.is_iterable()) {       // -j imposed by -J & not -rr
   for(auto &jn: jout)                                           // therefore push one by one
    global_json().push_back(move(jn));
@@ -1157,21 +1754,227 @@ void CommonResource::jsonize(Json jout) {
 
 
 
+void CommonResource::decide_on_cpu_limits(void) {
+ #include "lib/dbgflow.hpp"
+ // -C N[:cpus]: limit worker pools to N threads and pin workers of all pools (parsing,
+ // processing, pipeline stages, shell cli) to given cpus; there's no explicit NUMA binding,
+ // memory allocated by pinned workers (e.g. parsed JSONs) lands on their local nodes by the
+ // first-touch policy. Pools are process-wide, hence the option is taken from the first
+ // option set where it's given
+ for(size_t i = 0; i < total_decomposed(); ++i) {
+  if(opt(i)[CHR(OPT_CPU)].hits() == 0) continue;
+  const char * str = opt(i)[CHR(OPT_CPU)].c_str();
+  char * endptr;
+  size_t trds = *str == ':'? 0: strtoul(str, &endptr, 10);
+  vector<size_t> cpus;
+  if((*str != ':' and (endptr == str or (*endptr != CHR_NULL and *endptr != ':'))) or
+     (strchr(str, ':') != nullptr and not parse_cpus_(strchr(str, ':') + 1, cpus))) {
+   cerr << "fail: option -" STR(OPT_CPU) " expects N[:cpus] (e.g.: 4:0-1,8-9), given: '"
+        << str << "'" << endl;
+   exit(RC_ARG_FAIL);
+  }
+  if(trds == 0) trds = cpus.empty()? ThreadMaster::available_cpus(): cpus.size();
+  DBG(0) DOUT() << "worker threads per pool: " << trds << ", pinned to " << cpus.size()
+                << " cpu(s)" << endl;
+  tm_.resize(trds);
+  ptm_.resize(trds);
+  cpul_ = trds;
+  for(auto tm: {&tm_, &ptm_, &stm_, &xtm_}) tm->pin(cpus);
+  return;
+ }
+}
+
+
+
+void CommonResource::check_search_cache_limits(void) {
+ #include "lib/dbgflow.hpp"
+ // -L N: validate search caches limit (MB) in all option sets (it's applied in Jtc::demux_opt)
+ for(size_t i = 0; i < total_decomposed(); ++i) {
+  if(opt(i)[CHR(OPT_SCL)].hits() == 0) continue;
+  const char * str = opt(i)[CHR(OPT_SCL)].c_str();
+  char * endptr;
+  strtoul(str, &endptr, 10);
+  if(*endptr != CHR_NULL or endptr == str or *str == '-') {
+   cerr << "fail: option -" STR(OPT_SCL) " expects a number (MB), given: '" << str << "'" << endl;
+   exit(RC_ARG_FAIL);
+  }
+ }
+}
+
+
+
+void CommonResource::decide_on_shell_concurrency(void) {
+ #include "lib/dbgflow.hpp"
+ // -E N: size the pool running shell cli concurrently (-ee); -E0 sizes it as the processing
+ // pool, as well as -C N caps it; w/o -E cli are run one by one
+ size_t trds = 1;
+ for(size_t i = 0; i < total_decomposed(); ++i)
+  if(opt(i)[CHR(OPT_ECC)].hits() > 0) {
+   char * endptr;
+   trds = strtoul(opt(i)[CHR(OPT_ECC)].c_str(), &endptr, 10);
+   if(*endptr != CHR_NULL or endptr == opt(i)[CHR(OPT_ECC)].c_str()) {
+    cerr << "fail: option -" STR(OPT_ECC) " expects a number, given: '"
+         << opt(i)[CHR(OPT_ECC)].str() << "'" << endl;
+    exit(RC_ARG_FAIL);
+   }
+   if(trds == 0 or (cpul_ > 0 and trds > cpul_)) trds = ptm().seats_total();
+   DBG(0) DOUT() << "shell cli concurrency: " << trds << endl;
+   break;
+  }
+ xtm_.resize(trds);
+}
+
+
+
+bool CommonResource::parse_cpus_(const char *str, vector<size_t> & cpus) {
+ // parse cpu list, e.g.: "0-3,8,10-11", return false if malformed
+ do {
+  char * endptr;
+  size_t from = strtoul(str, &endptr, 10), to = from;
+  if(endptr == str) return false;
+  if(*endptr == '-') {
+   str = endptr + 1;
+   to = strtoul(str, &endptr, 10);
+   if(endptr == str or to < from or to - from > 0xFFFF) return false;
+  }
+  for(; from <= to; ++from) cpus.push_back(from);
+  str = endptr;
+ } while(*str++ == ',');
+ return str[-1] == CHR_NULL;
+}
+
+
+
 void CommonResource::decide_on_multithreaded_parsing(void) {
  #include "lib/dbgflow.hpp"
  // if conditions are right enable multi-threaded read/parsing
  if(tm().seats_total() == 1) return;                            // cpu should have more than 1 core
- if(read_from_cin_ == true) return;                             // must be reading from files
+ if(read_from_cin_ == true) {                                   // must be reading from files, or
+  if(iss().is_streamed() and opt()[CHR(OPT_DBG)].hits() == 0)   // pipeline streamed <stdin>
+   { json_store().resize(1); fetch_dispatcher_(); iss().defer_reading_files(); }
+  return;
+ }
  if(opt()[CHR(OPT_ALL)].hits() - opt().imposed(CHR(OPT_ALL)) > 0) return;  // -a disables m.t.
  if(opt()[0].hits() <= 1) return;                               // there must be more than 1 file
 
  json_store().resize(iss().filenames().size());                 // enable multithreading
- DBG(0) DOUT() << "starting dispatcher for json parsers in a new thread" << endl;
- tm().run(GLAMBDA(fetch_dispatcher_));                          // fetch jsons
+ jsq_bgt_.cap *= tm().seats_total();                            // JSQ_CAP per parsing thread
+ for(auto & jsq: json_store()) jsq.budget(jsq_bgt_);
+ json_store().front().prioritize();
+ unordered_ = opt()[CHR(OPT_UNO)].hits() > 0;                   // -o: consume JSONs as parsed
+ if(unordered_)
+  for(size_t i = 0; i < json_store().size(); ++i)
+   { json_store()[i].consumer_event(jsq_ev_); jsq_pend_.push_back(i); }
+ fetch_dispatcher_();                                            // fetch jsons
  iss().defer_reading_files();                                   // b/c m-thread reading is engaged
 }
 
 
+void CommonResource::decide_on_streamed_global_output(void) {
+ #include "lib/dbgflow.hpp"
+ // if -J given in the last option set only wraps outputs into an array (i.e. no later option
+ // set consumes gjsn_ and the array is printed as is), then stream its elements right into
+ // the output instead of accumulating them in gjsn_
+ auto & lo = opt(total_decomposed() - 1);                       // last option set
+ if(lo[CHR(OPT_JAL)].hits() == 0 or lo.imposed(CHR(OPT_JAL))) return;
+ if(iss().is_streamed()) return;                                // -J is reduced to -j there
+ if(lo[CHR(OPT_SZE)].hits() > 0 or lo[CHR(OPT_RAW)].hits() >= 2) return;  // -z, -rr need all
+ if(lo[CHR(OPT_FRC)].hits() > 0) return;                        // -f writes to a file
+ if(lo[CHR(OPT_IND)].str().back() == CHR(IND_SFX)) return;      // semi-compact needs all
+
+ DBG(0) DOUT() << "streaming global json (-" STR(OPT_JAL) ") into output" << endl;
+ gjwr_.open_array();
+ stream_gjsn_ = true;
+}
+
+
+void CommonResource::decide_on_parallel_processing(void) {
+ #include "lib/dbgflow.hpp"
+ // -P: engage processing of JSONs in worker threads, unless the options rely on the sequential
+ // processing. Jnode's format (-r, -t, -m) is global: all Jtc instances processing JSONs in
+ // parallel must apply the same one, hence -P requires a single option set (each instance is
+ // constructed in the main thread off the same options, workers only read the format)
+ bool given{false};
+ for(size_t i = 0; i < total_decomposed(); ++i)
+  given |= opt(i)[CHR(OPT_PAR)].hits() > 0;
+ if(not given) return;
+
+ const char * reason = total_decomposed() > 1? "chained option sets":
+                       iss().is_streamed()? "streamed input":
+                       opt()[CHR(OPT_DBG)].hits() > 0? "option -" STR(OPT_DBG):
+                       opt()[CHR(OPT_FRC)].hits() > 0? "option -" STR(OPT_FRC): nullptr;
+ if(reason != nullptr)
+  { cerr << "notice: option -" STR(OPT_PAR) " is ignored with " << reason << endl; return; }
+ parallel_ = true;
+}
+
+
+
+void CommonResource::decide_on_pipelining(void) {
+ #include "lib/dbgflow.hpp"
+ // chained option sets on streamed cin: run each option set as a pipeline stage (in own thread);
+ // stages construct Jtc instances concurrently, each applying Jnode's global format (-r, -t,
+ // -m) of its option set, hence all option sets must agree on the format
+ if(total_decomposed() < 2 or not iss().is_streamed() or ptm().seats_total() < 2) return;
+ auto format = [this](size_t i) {
+                return to_string(opt(i)[CHR(OPT_RAW)].hits()) + ":" +
+                       to_string(opt(i)[CHR(OPT_IND)].hits()) + ":" + opt(i)[CHR(OPT_IND)].str() +
+                       ":" + to_string(opt(i)[CHR(OPT_MDF)].hits() >= 2);
+               };
+ for(size_t i = 0; i < total_decomposed(); ++i)
+  if(opt(i)[CHR(OPT_DBG)].hits() > 0 or opt(i)[CHR(OPT_FRC)].hits() > 0 or
+     format(i) != format(0)) return;
+ pipelined_ = true;
+ stm_.resize(total_decomposed() - 1);                           // stages past the 1st one
+}
+
+
+
+bool CommonResource::close_streamed_global_output(void) {
+ #include "lib/dbgflow.hpp"
+ // close streamed global json (if any elements were written), return false if not streamed
+ if(not stream_gjsn_) return false;
+ if(gjwr_.array_elements() > 0)
+  gjwr_.close_array() << CHR_NLNE;
+ gjwr_.flush();
+ return true;
+}
+
+
+
+size_t CommonResource::next_jsq(void) {
+ #include "lib/dbgflow.hpp"
+ // return index of JsonStore to consume the next JSON from (jsd_.size() if none left):
+ // - in order: the current one (JsonStore::front() will await it)
+ // - unordered (-o): the current one if ready, otherwise first ready one (await if none)
+ if(not unordered_) return jsq_idx_;
+ if(jsq_pend_.empty()) return jsd_.size();
+ if(jsd_[jsq_idx_].is_ready()) return jsq_idx_;
+
+ jsq_ev_.await([&] {
+  for(auto idx: jsq_pend_)
+   if(jsd_[idx].is_ready()) { jsq_idx_ = idx; return true; }
+  return false;
+ });
+ return jsq_idx_;
+}
+
+
+
+void CommonResource::jsq_drained(size_t idx) {
+ #include "lib/dbgflow.hpp"
+ // all JSONs from JsonStore[idx] are consumed
+ if(not unordered_) jsq_idx_ = idx + 1;
+ else {
+  jsq_pend_.remove(idx);
+  if(not jsq_pend_.empty()) jsq_idx_ = jsq_pend_.front();
+ }
+ if(jsq_idx_ < jsd_.size() and jsq_idx_ != idx)                 // next store is exempt from
+  jsd_[jsq_idx_].prioritize();                                  // budget (ensures progress)
+}
+
+
+
 //
 // CR PRIVATE methods definitions
 //
@@ -1331,24 +2134,27 @@ bool CommonResource::is_x_factor_(const char * x_str, signed_size_t * recursive)
 
 
 void CommonResource::fetch_dispatcher_(void) {
- // dispatch threads fetching jsons when multiple files given
+ // queue tasks fetching jsons (one per file) into the thread pool when multiple files given,
+ // or a single reader/parser task when <stdin> is streamed
+ if(iss().is_streamed())
+  { tm().submit([this]{ read_and_parse_stream_(json_store().front()); }); return; }
  DBG(0) DOUT() << "got " << json_store().size() << " filename(s) to fetch via dispatcher" << endl;
  auto & fnv = iss().filenames();                                // file name vector
 
  auto rpj = [&](auto&&... arg)                                  // rpj: read & parse json
        { read_and_parse_json_(std::forward<decltype(arg)>(arg)...); };
 
- for(size_t i = 0; i < json_store().size(); ++i)                // spawn thread per each file
-  tm().run(rpj, ref(fnv[i]), ref(json_store()[i]));
+ for(size_t i = 0; i < json_store().size(); ++i)                // a task per each file
+  tm().submit(rpj, ref(fnv[i]), ref(json_store()[i]));
 }
 
 
 
 void CommonResource::read_and_parse_json_(const string &filename, JsonStore & js) {
- // isolated thread to read and parse all JSONs from file
- auto dummy = [&] { return true; };                             // b/c it comes in already locked
- auto remove_lock = [&](bool) { js.task_complete.unlock(); };
- GUARD(dummy, remove_lock)
+ // a pool's task to read and parse all JSONs from file, each JSON is handed over right away
+ auto dummy = [&] { return true; };
+ auto close_store = [&](bool) { js.close(); };
+ GUARD(dummy, close_store)
 
  // debugs may interleave with cout outputs (as the latter not mutex'ed), hence commented out
  //DBG(0) DOUT() << "parsing file " << filename << endl;
@@ -1362,12 +2168,12 @@ void CommonResource::read_and_parse_json_(const string &filename, JsonStore & js
   if(DBG()(0)) j.DBG().severity(NDBG);
   Streamstr::const_iterator jbegin = jsp;                       // for elocation only
   j.parse_throwing(false).parse(jsp, Json::Relaxed_trailing);
-  js.json_queue.push_back(move(j));
-  if(js.json_queue.back().parsing_failed()) {                   // exception occurred
+  bool failed = j.parsing_failed();
+  if(failed)                                                    // exception occurred
    js.err_location = Json::utf8_adjusted(0, jstream.str(),
-                                         distance(jbegin, js.json_queue.back().exception_point()));
-   break;
-  }
+                                         distance(jbegin, j.exception_point()));
+  js.push(move(j));
+  if(failed) break;
  }
  //DBG(0) DOUT() << "finished parsing file " << filename
  //              << ", parsed " << js.json_queue.size() << " json(s)" << endl;
@@ -1375,6 +2181,36 @@ void CommonResource::read_and_parse_json_(const string &filename, JsonStore & js
 
 
 
+void CommonResource::read_and_parse_stream_(JsonStore & js) {
+ // a pool's task to read and parse JSONs from streamed <stdin>: each JSON is handed over as soon
+ // as it's parsed, so reading of the next JSON overlaps with processing of the current one
+ auto dummy = [&] { return true; };
+ auto close_store = [&](bool) { js.close(); };
+ GUARD(dummy, close_store)
+
+ Streamstr jstream{Streamstr::streamed_cin};
+ auto jsp = jstream.begin();
+ js.file_status = Streamstr::Filestatus::Success;
+
+ while(jsp != jstream.end()) {
+  Json j;
+  auto pse = jsp;                                               // for blank trail detection
+  j.parse_throwing(false).parse(jsp, Json::Relaxed_no_trail);
+  if(j.parsing_failed()) {
+   if(j.exception_reason() == Jnode::unexpected_end_of_string) {
+    for(; pse.offset() < jsp.offset(); ++pse) if(*pse > CHR_SPCE) break;
+    if(pse.offset() == jsp.offset()) break;                     // blank trail, not a failure
+   }
+   js.err_location = jstream.stream_size() - 1;                 // same as exception_spot_()
+   js.push(move(j));
+   break;
+  }
+  js.push(move(j));
+ }
+}
+
+
+
 
 
 //
@@ -1416,33 +2252,34 @@ bool Jtc::parsejson(Streamstr::const_iterator &jsp, Streamstr::const_iterator &p
 bool Jtc::move_fetched_json(Streamstr::const_iterator &jsp) {
  #include "lib/dbgflow.hpp"
  // set json() to the fetched value in the other threads
- size_t idx = cr_.jsq_idx();                                    // idx for currently processed jsq
-
- while(idx < cr_.json_store().size()) {
-  cr_.global_ns()[FILE_NSP] = STR{cr_.iss().filenames()[idx]};  // update gns with current filename
+ for(size_t idx = cr_.next_jsq();                               // idx of jsq to process
+     idx < cr_.json_store().size(); idx = cr_.next_jsq()) {
+  cr_.global_ns()[FILE_NSP] = STR{cr_.iss().is_streamed()?     // update gns with current filename
+                                   cr_.iss().filename(): cr_.iss().filenames()[idx]};
   auto & jsq = cr_.json_store()[idx];                           // currently used queue from store
 
+  DBG(0) if(jsq.await_completion)
+   DOUT() << "awaiting parsing of the first json in another thread" << endl;
+  Json * jsn = jsq.front();                                     // await next json (or file's end)
   if(jsq.await_completion) {                                    // checking for the first time
-   DBG(0) DOUT() << "awaiting completion of another thread parsing" << endl;
-   jsq.task_complete.lock();                                    // thread supposed to release mutex
-   jsq.await_completion = false;                                // no further sync is required
+   jsq.await_completion = false;
    if(jsq.file_status == Streamstr::Filestatus::Failure)
     cerr << "error: could not open file '" << cr_.global_ns()[FILE_NSP].str() << "'" << endl;
   }
 
-  if(jsq.json_queue.empty())                                    // if all jsons released
-   { cr_.jsq_idx(++idx); continue; }                            // process next parsed json queue
+  if(jsn == nullptr)                                            // if all jsons released
+   { cr_.jsq_drained(idx); continue; }                          // process next parsed json queue
 
-  auto & jsn = jsq.json_queue.front();
-  if(jsn.parsing_failed()) {                                    // handle failed parsing
+  if(jsn->parsing_failed()) {                                   // handle failed parsing
    cr_.elocation(jsq.err_location);
-   cr_.iss().reset(Streamstr::buffered_file).source_file(cr_.global_ns()[FILE_NSP].str());
-   throw jsn.EXP(jsn.exception_reason());
+   if(cr_.iss().is_buffered())                                  // refer exception to the file
+    cr_.iss().reset(Streamstr::buffered_file).source_file(cr_.global_ns()[FILE_NSP].str());
+   throw jsn->EXP(jsn->exception_reason());
   }
 
-  json() = move(jsn);                                           // release json to processing
-  jsq.json_queue.pop_front();
-  if(jsq.json_queue.empty() and idx == cr_.json_store().size() - 1) // if last json was released
+  json() = move(*jsn);                                          // release json to processing
+  jsq.pop();
+  if(jsq.is_drained() and cr_.is_last_jsq(idx))                // if last json was released
    jsp = cr_.iss().end();                                       // then indicate the true end
   return true;
  }
@@ -1452,6 +2289,38 @@ bool Jtc::move_fetched_json(Streamstr::const_iterator &jsp) {
 
 
 
+void Jtc::commit_parallel(void) {
+ #include "lib/dbgflow.hpp"
+ // commit results of the JSON processed in a worker thread (-P): outputs, jsonized JSONs (-J),
+ // rc and namespaces (merged into global ones, like in run_single_optset)
+ jout_wr_.flush();
+ cout << pctx_->out.str();
+ for(auto &j: pctx_->gjsn) cr_.jsonize(move(j));
+ if(pctx_->rc != RC_OK) cr_.rc(pctx_->rc);
+ cr_.global_ns().sync_in(itr_pairs().empty()? last_wns_snapshot(): itr_pairs().back().ns,
+                         map_jnse::NsOpType::NsMoveAll);
+}
+
+
+
+void Jtc::commit_pipelined(CommonResource::Interim &itm) {
+ #include "lib/dbgflow.hpp"
+ // commit results of the JSON processed by a pipeline stage: console outputs, interim JSONs
+ // (-J), rc and namespaces are passed on in itm (down to the last stage, which outputs them)
+ itm.out += parallel_out();
+ for(auto &j: pctx_->gjsn)                                      // same as in jsonize()
+  if(opt().imposed(CHR(OPT_JSN)) and j.is_iterable())
+   for(auto &jn: j) itm.jsn.push_back(move(jn));
+  else
+   itm.jsn.push_back(move(j));
+ if(pctx_->rc != RC_OK) itm.rc = pctx_->rc;
+ itm.ns = move(pctx_->gns);
+ itm.ns.sync_in(itr_pairs().empty()? last_wns_snapshot(): itr_pairs().back().ns,
+                map_jnse::NsOpType::NsMoveAll);
+}
+
+
+
 // write_json(src_json, allow_jsonizing) prints only a **single** JSON:
 //   o will print size of src_json (if -zz given)
 //   o if -j given and jsonizing allowed, will encapsulate src_json into array: [ src_json ]
@@ -1459,6 +2328,8 @@ bool Jtc::move_fetched_json(Streamstr::const_iterator &jsp) {
 //   o if -J given then src_json (or [ src_json ]) is output to global json (gjsn_) while
 //     encapsulated into array and returns:
 //     - in such case write_json() will be called from main() once all JSONs are processed
+//     - unless -J output is streamed (last option set only wraps outputs), then jsonize()
+//       writes the elements out right away
 //   o then, if no -J: (i.e. non-empty gjsn_ always indicates that -J was processed) then
 //     DEMUX output destination - either to file (-f), or to console
 //   o if -qq given (overrides -rr) then jsonsizes (unqoutes) src_json if it's a JSON string
@@ -1501,17 +2372,20 @@ void Jtc::write_json(Json & json, Jsonizaion allow_encap) {
          << (write_to_file_?
               cr_.iss().filename():
               global_jsn? "<JSON>": opt()[CHR(OPT_JSN)]? "<json>": "<stdout>") << endl;
- if(global_jsn)                                                 // -J, jsonize to global, defer
-  { cr_.jsonize(move(json)); return; }                          // output until all JSON processed
+ if(global_jsn) {                                               // -J, jsonize to global, defer
+  if(pctx_) pctx_->gjsn.push_back(move(json));                  // in parallel - until committed
+  else cr_.jsonize(move(json));                                 // output until all JSON processed
+  return;
+ }
 
- Jtc::mod_ |= ios_base::app;                                    // next time will append
+ if(write_to_file_) Jtc::mod_ |= ios_base::app;                 // next time will append
 
  if(unquote_ and json.is_string())
-  { if(not json.str().empty()) xout_ << json.unquote_str(json.str()) << endl; }
- else xout_ << json << endl;
+  { if(not json.str().empty()) jout_wr_ << json.unquote_str(json.str()) << CHR_NLNE; }
+ else jout_wr_ << json << CHR_NLNE;
 
  if(opt()[CHR(OPT_SZE)].hits() == 1)                            // -z
-  xout_ << OBJ{LBL{JTCS_TKN, static_cast<double>(jsize)}} << endl;
+  jout_wr_ << OBJ{LBL{JTCS_TKN, static_cast<double>(jsize)}} << CHR_NLNE;
 }
 
 
@@ -1523,6 +2397,12 @@ bool Jtc::demux_opt(void) {
  if(opt()[CHR(OPT_WLK)].hits() == 0 and opt()[CHR(OPT_TMP)].hits() >= 1)  // no -w, but -T is given
   opt()[CHR(OPT_WLK)] = "";                                     // provide default walk off root
 
+ json().search_index(opt()[CHR(OPT_IDX)].hits() > 0)            // -X: engage search index
+       .re_captures(cr_.is_re_captured())
+       .search_cache_limit(opt()[CHR(OPT_SCL)].hits() == 0?     // -L: bound search caches
+                            SRCH_CACHE_MAX: strtoul(opt()[CHR(OPT_SCL)].c_str(), nullptr, 10)
+                                            * 1024 * 1024);
+
  bool is_tampered{false};
  for(char op: STR(OPT_CMP)STR(OPT_INS)STR(OPT_UPD)STR(OPT_SWP)STR(OPT_PRG)STR(OPT_WLK)) {
   if(op == CHR_NULL or opt()[op].hits() == 0) continue;
@@ -1598,11 +2478,11 @@ void Jtc::compare_bindings(void) {
 
   for(auto &json: jv) {                                         // output compared jsons
    auto jit = json.walk("[0]");
-   if(not jit->is_empty()) cr_.rc(RC_CMP_NEQ);
+   if(not jit->is_empty()) rc_(RC_CMP_NEQ);
    output_by_iterator(jit);
   }
   if(jv.front().front().type() != jv.back().front().type())
-   cr_.rc(RC_CMP_NEQ);
+   rc_(RC_CMP_NEQ);
  }
 }
 
@@ -1809,8 +2689,10 @@ void Jtc::apply_src_walks(char op) {
 
  vec_bjit vsrc(psrc_.size());                                   // copy of valid iterators
  vector<ShellReturn> vsr;
+ vector<future<ShellReturn>> vfsr;                              // cli run ahead (-E)
  Json jexec;                                                    // for temp. copy of jsrc_[0]
  if(ecli_ == Ecli::Bulk_exec) vsr = run_bulk_shell_();
+ else if(ecli_ == Ecli::Per_walk_exec) vfsr = run_concurrent_shell_();
 
  for(size_t i = 0; i < psrc_.size(); ++i) {
   auto &pair = psrc_[i];
@@ -1824,7 +2706,10 @@ void Jtc::apply_src_walks(char op) {
   if(ecli_ > Ecli::No_exec) {
    jexec = jsrc_[0];
    if(DBG()(0)) DBG().increment(+2, jexec, -2);
-   is_ecli_success = execute_cli_(jexec, pair.src, pair.ns, vsr.size()? &vsr[i]: nullptr);
+   ShellReturn sr, * srptr = vsr.size()? &vsr[i]: nullptr;
+   if(i < vfsr.size() and vfsr[i].valid())
+    { sr = vfsr[i].get(); srptr = &sr; }
+   is_ecli_success = execute_cli_(jexec, pair.src, pair.ns, srptr);
    ewlk = jexec.walk();
   }
 
@@ -1892,7 +2777,7 @@ void Jtc::swap_json(void) {
    if(not swaps1[i].is_valid() or not swaps2[i].is_valid()) {
     cerr << "error: walk instance " << i
          << " became invalid due to prior operations, skipping" << endl;
-    cr_.rc(RC_WP_INV);
+    rc_(RC_WP_INV);
     break;
    }
    if(not swaps1[i].is_nested(swaps2[i]))
@@ -1916,6 +2801,12 @@ void Jtc::walk_json(void) {
  }
 
  if(opt()[CHR(OPT_JSN)].hits() == 1) jout_ = ARY{};             // otherwise jout_ is OBJ (i.e -jj)
+ stream_ary_ = jout_.is_array() and                             // a plain array (-j, no -l) could
+               opt()[CHR(OPT_LBL)].hits() == 0 and              // be streamed right into output
+               opt()[CHR(OPT_JAL)].hits() == 0 and              // unless it's -J, -rr, -z, -zz, or
+               not measure_ and (unquote_ or not inquote_) and  // a semi-compact format
+               not json().is_semicompact();
+ if(stream_ary_) jout_wr_.open_array();
  walk_interleaved_(&Jtc::output_by_iterator);
 
  if(use_hpfx_ and wcnt_ > 0 and opt().process_last(wcnt_)) {    // if there was output
@@ -1929,7 +2820,10 @@ void Jtc::walk_json(void) {
  }
 
  // after walking all paths
- if(opt()[CHR(OPT_JSN)].hits() > 0)                             // -j, jout_ contains the output
+ if(stream_ary_)                                                // -j, elements already streamed
+  { jout_wr_.close_array() << CHR_NLNE; if(write_to_file_) Jtc::mod_ |= ios_base::app; }
+ else
+  if(opt()[CHR(OPT_JSN)].hits() > 0)                            // -j, jout_ contains the output
    write_json(jout_, Dont_jsonize);                             // jsonization is done by walking
                                                                 // otherwise it's already stdout'ed
  // check json integrity...
@@ -1960,8 +2854,11 @@ void Jtc::output_by_iterator(Json::iterator &wi, Grouping grp) {
  Json tmp;                                                      // template-interpolation goes here
  tmp.type(Jnode::Neither);
  if(DBG()(0)) DBG().increment(+2, tmp, -2);                     // imbue current dbg +3 in tmp
+ bool output = opt().wm().empty() or opt().process_walk(wcnt_); // output taking into account -xn/n
+ bool prepare = output or                                       // prepare output unless it's not
+                (use_hpfx_ and (tmp_hpfx_ or wlast_));          // referred by {$?}, or by -x0/-1
 
- if(use_hpfx_) {
+ if(use_hpfx_ and prepare) {
   auto found = wns_[&wi].find(WLK_RSTH);
   if(found != wns_[&wi].end() and wns_[&wi].find(WLK_RSTH)->VALUE.bul() == true)
    hwlk_[0] = STR{};
@@ -1977,20 +2874,21 @@ void Jtc::output_by_iterator(Json::iterator &wi, Grouping grp) {
   size_t tmp_idx = is_tpw_?
          wi.walk_uid(): key_++ % (opt()[CHR(OPT_TMP)].size() - 1);
   ins_.sync_out(wns_[&wi], map_jnse::NsUpdateRef);              // this is done so that walks could
-  tmp = Json::interpolate(tpw_[tmp_idx], wi, wns_[&wi]);        // propagate namespaces interleaved
+  if(prepare)                                                   // propagate namespaces interleaved
+   tmp = Json::interpolate(tpw_[tmp_idx], wi, wns_[&wi]);
   ins_.sync_in(wns_[&wi], map_jnse::NsReferAll);
-  if(use_hpfx_) hwlk_ = move(ARY{tmp.root()});
+  if(use_hpfx_ and prepare) hwlk_ = move(ARY{tmp.root()});
  }
 
 
- if(use_hpfx_ and hwlk_[0].is_neither()) {                      // templating failed or was none
+ if(use_hpfx_ and prepare and hwlk_[0].is_neither()) {          // templating failed or was none
   if(wi->has_label()) hwlk_ = move(OBJ{LBL{wi->label(), *wi}}); // preserve also the label if exist
   else hwlk_ = move(ARY{*wi});
  }
 
  typedef void (Jtc::*jd_ptr)(Json::iterator &, Json &, Grouping);   // demux cout and -j outputs
  static jd_ptr demux_out[2] = {&Jtc::console_output_, &Jtc::jsonized_output_};
- if(opt().wm().empty() or opt().process_walk(wcnt_))            // output taking into account -xn/n
+ if(output)
   (this->*demux_out[opt()[CHR(OPT_JSN)].hits() > 0])(wi, tmp, grp);
  last_ = grp;
  ++wcnt_;
@@ -2493,6 +3391,41 @@ vector<Jtc::ShellReturn> Jtc::run_bulk_shell_(void) {
 
 
 
+vector<future<Jtc::ShellReturn>> Jtc::run_concurrent_shell_(void) {
+ #include "lib/dbgflow.hpp"
+ // run cli of -ee walks in a pool of concurrent shells (-E N), results are applied in walk order;
+ // cli is run ahead only if no prior walk update could invalidate (or alter) its walk, i.e.
+ // when none of prior dst walks nests it, otherwise it's left to run in turn (invalid future).
+ // Return empty vector (i.e. run all cli one by one) if no concurrency given (or bulk -e
+ // has reverted to running cli one by one)
+ vector<future<ShellReturn>> vfsr;
+ if(cr_.xtm().seats_total() < 2 or opt()[CHR(OPT_EXE)].hits() < 2 or
+    psrc_.size() < 2 or DBG()(0)) return vfsr;
+
+ vfsr.resize(psrc_.size());
+ size_t ahead = 0;
+ for(size_t i = 0; i < psrc_.size(); ++i) {
+  auto &pair = psrc_[i];
+  if(not pair.dst.is_valid()) continue;
+  if(jsrt_ == Src_input and not pair.src.is_valid()) continue;
+  bool nested = false;
+  for(size_t j = 0; j < i and not nested; ++j)
+   nested = psrc_[j].dst.is_nested(pair.dst) or
+            (jsrt_ == Src_input and psrc_[j].dst.is_nested(pair.src));
+  if(nested) continue;
+  vfsr[i] = cr_.xtm().submit([](string cli) {
+                              Shell sh;
+                              sh.system(cli);
+                              return ShellReturn{move(sh.out()), sh.rc()};
+                             }, interpolate_shell_str_(pair.src, pair.ns));
+  ++ahead;
+ }
+ DBG(1) DOUT() << "cli run ahead: " << ahead << " out of " << psrc_.size() << endl;
+ return vfsr;
+}
+
+
+
 bool Jtc::execute_cli_(Json &json, Json::iterator &jit, Json::map_jne &ns, ShellReturn * srptr) {
  #include "lib/dbgflow.hpp"
  // execute cli in -i/u option (interpolating jit if required) and parse the result into json
@@ -2597,7 +3530,7 @@ Jtc::vec_jit Jtc::collect_walks_(const string &walk_path) {
  }
 
  // standalone -p/-pp or -s
- cr_.global_ns().sync_out(json().clear_ns().ns(), map_jnse::NsOpType::NsReferAll);
+ global_ns_().sync_out(json().clear_ns().ns(), map_jnse::NsOpType::NsReferAll);
  for(auto it = json().walk(walk_path, Json::Keep_cache); it != json().end(); ++it)
   walk_itr.push_back(it);
  wns_[last_dwi_ptr_].sync_in(json().ns(), map_jnse::NsMoveAll);
@@ -2611,14 +3544,17 @@ Jtc::vec_jit Jtc::collect_walks_(const string &walk_path) {
 
 // interleaved walks engaged when multiple walk paths are given (in absence of -n)
 // processing of interleaved walks is somewhat complex:
-// 1. collect all iterators produced by each walk path into a vector (wpi), e.g
-//    [ [w0_i0, w0_i1, w0_iend],
-//      [w1_i0, w1_i1, w1_i2, w1_iend],
+// 1. each walk path is walked by a feed into own queue of iterators (wpi), e.g
+//    [ [w0_i0, w0_i1],
+//      [w1_i0, w1_i1],
 //      [...],
 //      ...
 //    ]
-// 2. for all instances build a matrix from front iterators offsets (fom) only, for
-//    entire walk state:
+//    - when walks are output (output_by_iterator) feeds walk lazily: only one instance ahead
+//      of the front one, otherwise (-i/-u/-c) all walks are walked in full beforehand, as
+//      those subscribers walk own sources (might be over the same json and its namespace)
+//    - with -n a single feed walks all walk paths, one after another
+// 2. build a matrix from front iterators offsets (fom) only, a row per each queue:
 //    - iterator offset for a built walk state returns -1 if walk step is non-iterable,
 //      otherwise walk position's current offset is returned, e.g.:
 //      w0_i0 and w1_i0, result in the probable FOM:
@@ -2627,52 +3563,42 @@ Jtc::vec_jit Jtc::collect_walks_(const string &walk_path) {
 // 3. then build a vector referring *actual* instances: *actual* is the instance that is
 //    non-empty (e.g.: 0, 1)
 // 4. among actual iterators, select first in the relevant group, give it to the subscriber
-//    and remove it from the wpi
-// 5. repeat until entire wpi is empty
+//    and remove it from its queue, then advance the feed and rebuild its row in fom only
+// 5. repeat until all queues are empty
 //
 // Namespaces:
 // each walk (-w) starts with a blank namespace sync'ing only global NS (which carries namespaces
 // from prior option sets).
-// each walk's iteration namespaces are also preserved in (NS per each iterator in wns_)
+// each walk's iteration namespaces are also preserved in (NS per each iterator in wns_); all
+// feeds walk the same json, thus json's namespace is restored from the latest walked instance
+// before advancing a walk; NS of consumed lazy instances are dropped (see retire_walk_ns_)
 
 void Jtc::walk_interleaved_(wlk_subscr Jtc::* subscriber) {
  #include "lib/dbgflow.hpp"
- // collect all walks (-w) and feed one by one to the subscriber
+ // walk all walks (-w) and feed them one by one to the subscriber
  subscriber_ = subscriber;
  deque<deq_jit> wpi;                                            // wpi holds queues of iterators
-
- for(const auto &walk_str: opt()[CHR(OPT_WLK)]) {               // process each -w arguments
-  cr_.global_ns().sync_out(json().clear_ns().ns(), map_jnse::NsOpType::NsReferAll);
-
-  // wpi: push back deq_jit init'ed with -w inited walk
-  wpi.push_back( deq_jit{json().walk(walk_str.find_first_not_of(" ") == string::npos?
-                                     "": walk_str, Json::Keep_cache)} );
-  if(is_tpw_ and subscriber == &Jtc::output_by_iterator)        // only for -w -T combination
-   tpw_.emplace(wpi.back().front().walk_uid(),                  // relate interleaved walks to tmp
-                tpw_.size() < opt()[CHR(OPT_TMP)].size() - 1?
-                 opt()[CHR(OPT_TMP)].str(tpw_.size() + 1): "");
-
-  if(opt()[CHR(OPT_SEQ)].hits() % 2 == 1 and wpi.size() > 1) {  // -n and multiple -w given
-   wpi.front().push_back( move(wpi.back().front()) );           // move queue to front wpi
-   wpi.pop_back();                                              // drop last instance
-  }
-  auto & dwi = wpi.back();                                      // dwi: deque<Json::iterator>
-  while(dwi.back() != dwi.back().end()) {                       // extend all iterators until end
-   wns_[&dwi.back()].sync_in(json().ns(), map_jnse::NsMove);
-   if(use_hpfx_) {
-    wns_[&dwi.back()][WLK_RSTH] = BUL{wns_[&dwi.back()].erase(WLK_HPFX)? true: false};
-    if(dwi.back()->has_label()) hwlk_ = move(OBJ{ LBL{dwi.back()->label(), *dwi.back()} });
-    else hwlk_ = move(ARY{*dwi.back()});
-   }
-   wns_[&dwi.back()].sync_out(json().clear_ns().ns(), map_jnse::NsReferAll);
-   last_dwi_ptr_ = &dwi.back();
-   dwi.push_back(dwi.back());                                   // make new copy (next instance)
-   ++dwi.back();                                                // json.ns now is partial
+ vector<WalkFeed> feeds;                                        // walk feeds of wpi's queues
+
+ wlim_ = subscriber == &Jtc::output_by_iterator? walk_bound_(): SIZE_T(-1);
+ if(wlim_ == SIZE_T(-1) and is_walk_concurrent_(subscriber))    // expand walks in worker threads
+  walk_concurrently_(wpi);
+ else {                                                         // walk in json one by one
+  auto & walks = opt()[CHR(OPT_WLK)];
+  for(size_t i = 1; i < walks.size(); ++i) {                    // compile all walks upfront, so
+   if(walks.str(i).find_first_not_of(" ") == string::npos) continue;
+   Json::iterator it;                                           // that failing ones won't
+   json().compile_walk(walks.str(i), it);                       // interrupt lazy walking
   }
-  dwi.pop_back();                                               // remove last (->end()) iterator
-  // json.ns() may hold now the latest updated namespace while wns_ might not even have been
-  // updated (e.g.: when walk has ended as <>F, or out of iterations), thus require syncing
-  wns_[last_dwi_ptr_].sync_in(json().ns(), map_jnse::NsOpType::NsUpdate);
+  bool lazy = subscriber == &Jtc::output_by_iterator;
+  bool seq = opt()[CHR(OPT_SEQ)].hits() % 2 == 1;               // -n: all walks in one feed
+  for(size_t i = 1; i < walks.size(); ++i)
+   if(not seq or i == 1) {
+    wpi.emplace_back();
+    feeds.push_back(WalkFeed{i, seq? walks.size(): i + 1, lazy});
+   }
+  for(size_t idx = 0; idx < feeds.size(); ++idx)                // feeds walk in order of -w
+   advance_walk_(wpi, feeds, idx);
  }
  hwlk_ = move(ARY{STR{}});                                      // reset hwlk_ to init value
 
@@ -2683,66 +3609,304 @@ void Jtc::walk_interleaved_(wlk_subscr Jtc::* subscriber) {
   DOUT() << "multi-walk: " << (is_multi_walk_? "true": "false") << endl;
   DOUT() << DBG_PROMPT(1) << "interleaved walk-path instances (-w: " << wpi.size() << "):" << endl;
   for(size_t i = 0; i < wpi.size(); ++i)
-   DOUT() << DBG_PROMPT(1) << "instance: " << i << ", iterators: " << wpi[i].size() << endl;
+   DOUT() << DBG_PROMPT(1) << "instance: " << i << ", iterators (walked ahead): "
+          << wpi[i].size() << endl;
  }
 
- while( any_of(wpi.begin(), wpi.end(), [](deq_jit &wi){ return not wi.empty(); }) )
-  process_walk_iterators_(wpi);
+ process_walk_iterators_(wpi, feeds);
+
+ for(auto wf = feeds.rbegin(); wf != feeds.rend(); ++wf)        // latest walked instance holds
+  if(wf->last != nullptr) {                                     // the last NS snapshot
+   last_dwi_ptr_ = wf->last;
+   if(wf->lns != nullptr) wns_[last_dwi_ptr_] = move(*wf->lns); // consumed lazily
+   break;
+  }
+ for(auto &dwi: wpi)                                            // walks stopped by -x/N: drop NS
+  for(auto &wi: dwi)                                            // of instances never consumed
+   if(&wi != last_dwi_ptr_) wns_.erase(&wi);
+ wctx_.clear();                                                 // walked: release walk contexts
 }
 
 
 
-void Jtc::process_walk_iterators_(deque<deq_jit> &wpi) {
+size_t Jtc::walk_bound_(void) {
  #include "lib/dbgflow.hpp"
- // build front iterators offset matrix: wpi may contain empty deque
+ // output walks might be stopped once no further instance could be selected by -x/N, unless
+ // walking carries other effects: walk steps updating namespaces (those are passed on to next
+ // JSONs and option sets), running callbacks (<..>u), or tracking of the last walk ($?)
+ size_t bound = opt().walk_bound();
+ if(bound == SIZE_T(-1) or use_hpfx_) return SIZE_T(-1);
+
+ try {
+  for(const auto &walk_str: opt()[CHR(OPT_WLK)]) {
+   if(walk_str.find_first_not_of(" ") == string::npos) continue;
+   Json::iterator it;
+   json().compile_walk(walk_str, it);
+   for(size_t i = 0; i < it.walk_size(); ++i)
+    if(it.is_ns_updating(i) or it.type(i) == Json::Jsearch::user_handler) return SIZE_T(-1);
+  }
+ }
+ catch(...) { return SIZE_T(-1); }                              // walking will report it
+ DBG(0) DOUT() << "walking is bounded (-x) to instances: " << bound << endl;
+ return bound;
+}
+
+
+
+bool Jtc::is_walk_concurrent_(wlk_subscr Jtc::* subscriber) {
+ #include "lib/dbgflow.hpp"
+ // multiple walks (-w) are expanded concurrently only when walking standalone (json is not
+ // modified then), none of walks runs callbacks (<..>u), on a multi-core cpu and unless
+ // JSONs are already processed in parallel (-P)
+ if(subscriber != &Jtc::output_by_iterator or opt()[CHR(OPT_WLK)].size() <= 2) return false;
+ if(pctx_ or DBG()(0) or cr_.ptm().seats_total() == 1) return false;
+
+ try {
+  for(const auto &walk_str: opt()[CHR(OPT_WLK)]) {
+   if(walk_str.find_first_not_of(" ") == string::npos) continue;
+   Json::iterator it;
+   json().compile_walk(walk_str, it);
+   for(size_t i = 0; i < it.walk_size(); ++i)
+    if(it.type(i) == Json::Jsearch::user_handler) return false;
+  }
+ }
+ catch(...) { return false; }                                   // sequential walk will report it
+ return true;
+}
+
+
+
+void Jtc::walk_concurrently_(deque<deq_jit> &wpi) {
+ #include "lib/dbgflow.hpp"
+ // expand each walk (-w) in a worker thread within own walk context (sharing json's tree, but
+ // having own namespace and search caches), then lay out walked iterators and their namespaces
+ // the same way walk_interleaved_() does
+ auto & walks = opt()[CHR(OPT_WLK)];
+ size_t total = walks.size() - 1;                               // size() includes default value
+ vector<deq_jit> dwi(total);
+ vector<deque<map_jnse>> dns(total);
+ vector<size_t> uid(total);
+ for(size_t i = 0; i < total; ++i) {                            // ready walk contexts
+  wctx_.emplace_back();
+  wctx_.back().share_root(json()).search_index(json().is_search_indexed())
+               .re_captures(json().is_re_captured())
+               .search_cache_limit(json().search_cache_limit());
+  global_ns_().sync_out(wctx_.back().ns(), map_jnse::NsOpType::NsReferAll);
+ }
+
+ auto expand = [&](size_t i)
+               { uid[i] = expand_walk_(wctx_[i], walks.str(i + 1), dwi[i], dns[i]); };
+ vector<future<void>> fut;
+ for(size_t i = 1; i < total; ++i)                              // 1st walk is expanded here
+  fut.push_back(cr_.ptm().submit(expand, i));
+ try {
+  expand(0);
+  for(auto &f: fut) f.get();                                    // rethrows in order of walks
+ }
+ catch(...) {
+  for(auto &f: fut) if(f.valid()) f.wait();                     // walks use dwi, dns
+  throw;
+ }
+
+ for(size_t i = 0; i < total; ++i) {
+  if(is_tpw_)                                                   // relate interleaved walks to tmp
+   tpw_.emplace(uid[i], tpw_.size() < opt()[CHR(OPT_TMP)].size() - 1?
+                         opt()[CHR(OPT_TMP)].str(tpw_.size() + 1): "");
+  if(opt()[CHR(OPT_SEQ)].hits() % 2 == 0 or i == 0)             // -n: all walks into front wpi
+   wpi.push_back(deq_jit{});
+  auto & dst = wpi.back();
+  for(size_t j = 0; j < dwi[i].size(); ++j) {
+   dst.push_back(move(dwi[i][j]));
+   wns_[&dst.back()] = move(dns[i][j]);
+   last_dwi_ptr_ = &dst.back();
+  }
+  wns_[last_dwi_ptr_].sync_in(wctx_[i].ns(), map_jnse::NsOpType::NsUpdate);
+ }
+}
+
+
+
+size_t Jtc::expand_walk_(Json &ctx, const string &walk_str, deq_jit &dwi, deque<map_jnse> &dns) {
+ // expand all instances of the walk in the given walk context, collect their namespaces;
+ // return walk's uid
+ dwi.push_back(ctx.walk(walk_str.find_first_not_of(" ") == string::npos? "": walk_str,
+                        Json::Keep_cache));
+ size_t uid = dwi.front().walk_uid();
+ while(dwi.back() != dwi.back().end()) {                        // extend all iterators until end
+  dns.emplace_back();
+  dns.back().sync_in(ctx.ns(), map_jnse::NsMove);
+  if(use_hpfx_)
+   dns.back()[WLK_RSTH] = BUL{dns.back().erase(WLK_HPFX)? true: false};
+  dns.back().sync_out(ctx.clear_ns().ns(), map_jnse::NsReferAll);
+  dwi.push_back(dwi.back());                                    // make new copy (next instance)
+  ++dwi.back();
+ }
+ dwi.pop_back();                                                // remove last (->end()) iterator
+ return uid;
+}
+
+
+
+void Jtc::advance_walk_(deque<deq_jit> &wpi, vector<WalkFeed> &feeds, size_t idx) {
+ #include "lib/dbgflow.hpp"
+ // walk feed's walk path(s) until one instance is ready past the front one (lazy feed), or
+ // until all are walked; other feeds might have walked json meanwhile, thus json's namespace
+ // is restored from the latest walked instance before advancing the walk
+ auto & dwi = wpi[idx];                                         // dwi: deque<Json::iterator>
+ auto & wf = feeds[idx];
+ while(not wf.lazy or dwi.size() < 2) {
+  if(not wf.walking) {                                          // begin walking next -w
+   if(wf.next == wf.end) return;                                // all walks of the feed walked
+   const string & walk_str = opt()[CHR(OPT_WLK)].str(wf.next++);
+   global_ns_().sync_out(json().clear_ns().ns(), map_jnse::NsOpType::NsReferAll);
+   dwi.push_back(json().walk(walk_str.find_first_not_of(" ") == string::npos?
+                             "": walk_str, Json::Keep_cache));
+   if(is_tpw_ and subscriber_ == &Jtc::output_by_iterator)      // only for -w -T combination
+    tpw_.emplace(dwi.back().walk_uid(),                         // relate interleaved walks to tmp
+                 tpw_.size() < opt()[CHR(OPT_TMP)].size() - 1?
+                  opt()[CHR(OPT_TMP)].str(tpw_.size() + 1): "");
+   wf.walking = true;
+  }
+  else {                                                        // walk the next instance
+   wns_[&dwi.back()].sync_out(json().clear_ns().ns(), map_jnse::NsOpType::NsReferAll);
+   dwi.push_back(dwi.back());                                   // make new copy (next instance)
+   ++dwi.back();                                                // json.ns now is partial
+  }
+
+  if(dwi.back() == dwi.back().end()) {                          // walk has ended
+   dwi.pop_back();                                              // remove last (->end()) iterator
+   wf.walking = false;
+   end_walk_(feeds, idx);
+   continue;
+  }
+  auto & ns = wns_[&dwi.back()];
+  ns.sync_in(json().ns(), map_jnse::NsMove);
+  if(use_hpfx_) {                                               // flag only resets of $?, so that
+   if(ns.erase(WLK_HPFX)) ns[WLK_RSTH] = BUL{true};             // NS is not held on otherwise (see
+   else ns.erase(WLK_RSTH);                                     // retire_walk_ns_)
+  }
+  wf.last = &dwi.back();
+ }
+}
+
+
+
+void Jtc::end_walk_(vector<WalkFeed> &feeds, size_t idx) {
+ #include "lib/dbgflow.hpp"
+ // json.ns() may hold now the latest updated namespace while wns_ might not even have been
+ // updated (e.g.: when walk has ended as <>F, or out of iterations), thus require syncing into
+ // the latest walked instance (of a prior walk, if this one walked none)
+ auto & wf = feeds[idx];
+ if(wf.last != nullptr) {
+  wns_[wf.last].sync_in(json().ns(), map_jnse::NsOpType::NsUpdate);
+  for(auto &ns: wf.ens)                                         // followed by NS of empty walks
+   wns_[wf.last].sync_in(ns, map_jnse::NsOpType::NsUpdate);
+  wf.ens.clear();
+  return;
+ }
+
+ for(size_t i = idx; i-- > 0;)                                  // walk of a prior feed
+  if(feeds[i].last != nullptr) {
+   if(not feeds[i].walking)
+    { wns_[feeds[i].last].sync_in(json().ns(), map_jnse::NsOpType::NsUpdate); return; }
+   feeds[i].ens.emplace_back();                                 // not ended yet: sync once ended
+   feeds[i].ens.back().sync_in(json().ns(), map_jnse::NsOpType::NsMove);
+   return;
+  }
+ wns_[last_dwi_ptr_].sync_in(json().ns(), map_jnse::NsOpType::NsUpdate);
+}
+
+
+
+void Jtc::retire_walk_ns_(Json::iterator &wi, WalkFeed &wf) {
+ #include "lib/dbgflow.hpp"
+ // drop NS of a consumed instance (of a lazy feed): its local entries might be referred by
+ // namespaces of later instances (or by ins_, json's), then it's preserved in rns_, so is
+ // the NS of the feed's last instance (it might provide the last NS snapshot)
+ auto found = wns_.find(&wi);
+ if(found == wns_.end()) return;
+ if(&wi == wf.last or
+    any_of(found->VALUE.begin(), found->VALUE.end(),
+           [](const Json::map_jne::value_type &ns) { return ns.VALUE.is_local(); })) {
+  rns_.push_back(move(found->VALUE));
+  if(&wi == wf.last) wf.lns = &rns_.back();
+ }
+ wns_.erase(found);
+}
+
+
+
+void Jtc::process_walk_iterators_(deque<deq_jit> &wpi, vector<WalkFeed> &feeds) {
+ #include "lib/dbgflow.hpp"
+ // merge walk queues (wpi may contain empty ones) by front iterators offsets: the front offset
+ // matrix is built once, then only the row of the consumed queue is rebuilt
  vector<vector<signed_size_t>> fom(wpi.size());                 // front offset matrix
+ for(size_t idx = 0; idx < wpi.size(); ++idx)                   // build FOM here
+  build_front_row_(fom[idx], wpi[idx], idx);
 
- size_t longest_walk = build_front_grid_(fom, wpi);             // build FOM here
  vector<size_t> actual_instances;                               // ai: those which not ended yet
  actual_instances.reserve(fom.size());
- for(size_t idx = 0; idx < fom.size(); ++idx)                   // init non-empty fom indices
-  if(not fom[idx].empty()) actual_instances.push_back(idx);
+ while(true) {
+  size_t longest_walk = 0;                                      // longest row in the fom matrix
+  actual_instances.clear();
+  for(size_t idx = 0; idx < fom.size(); ++idx)                  // init non-empty fom indices
+   if(not fom[idx].empty())
+    { actual_instances.push_back(idx); longest_walk = max(longest_walk, fom[idx].size()); }
+  if(actual_instances.empty()) return;                          // all queues are consumed
+  if(wcnt_ >= wlim_) {                                          // none further selected by -x/N
+   DBG(1) DOUT() << "walked instances past -x selection, stop walking" << endl;
+   return;
+  }
 
- process_offsets_(wpi, fom, longest_walk, actual_instances);
+  Grouping grp = process_offsets_(fom, longest_walk, actual_instances);
+  if(actual_instances.empty()) return;                          // should never be the case
+  size_t idx = actual_instances.front();
+  size_t left = 0;                                              // walked instances left
+  for(auto &dwi: wpi) left += dwi.size();                       // (lazy feeds walk one ahead)
+  wlast_ = left == 1;
+  (this->*subscriber_)(wpi[idx].front(), grp);
+  wlast_ = true;
+  if(not feeds.empty() and feeds[idx].lazy)
+   retire_walk_ns_(wpi[idx].front(), feeds[idx]);
+  wpi[idx].pop_front();
+  if(not feeds.empty())                                         // walk ahead of the new front
+   advance_walk_(wpi, feeds, idx);
+  build_front_row_(fom[idx], wpi[idx], idx);
+ }
 }
 
 
 
-size_t Jtc::build_front_grid_(vector<vector<signed_size_t>> &fom, const deque<deq_jit> &wpi) {
+void Jtc::build_front_row_(vector<signed_size_t> &row, const deq_jit &dwi, size_t idx) {
  #include "lib/dbgflow.hpp"
- // build matrix from front iterator of each walk (FOM): using iterator's counter() method
+ // build matrix row from the front iterator of a walk (FOM): using iterator's counter() method
  // that way it'll be possible to group relevant walk-paths during output
- size_t longest = 0;                                            // longest row in the fom matrix
- string dlm;                                                    // for debug output only
- for(size_t idx = 0; idx < wpi.size(); ++idx) {                 // go over all given walk paths -w
-  auto & wi = wpi[idx];                                         // set of iterators for -w instance
-  if(wi.empty()) continue;                                      // no more iterators in this walk
+ row.clear();
+ if(dwi.empty()) return;                                        // no more iterators in this walk
 
-  DBG(3) {
-   DOUT() << "walkpath (-w) instance " << idx;                  // go over walk path counters only
-   dlm = " front ws_counters matrix: ";                         // of the front iterator's instance
-  }
-  fom[idx].reserve(wi.front().walk_size());                     // optimize memory management
-  for(size_t position = 0; position < wi.front().walk_size(); ++position) {
-   if(wi.front().walks()[position].is_directive()) continue;
-   fom[idx].push_back( wi.front().counter(position) );
-   if(DBG()(3)) { DOUT() << dlm << fom[idx].back(); dlm = ", "; }
-  }
-
-  if(fom[idx].empty()) fom[idx].push_back( -1 );                // ensure fom filled for: -w'<vv>v'
-  if(DBG()(3)) DOUT() << endl;
-  longest = max(longest, fom[idx].size());
+ string dlm;                                                    // for debug output only
+ DBG(3) {
+  DOUT() << "walkpath (-w) instance " << idx;                   // go over walk path counters only
+  dlm = " front ws_counters matrix: ";                          // of the front iterator's instance
+ }
+ row.reserve(dwi.front().walk_size());                          // optimize memory management
+ for(size_t position = 0; position < dwi.front().walk_size(); ++position) {
+  if(dwi.front().walks()[position].is_directive()) continue;
+  row.push_back( dwi.front().counter(position) );
+  if(DBG()(3)) { DOUT() << dlm << row.back(); dlm = ", "; }
  }
 
- return longest;
+ if(row.empty()) row.push_back( -1 );                           // ensure fom filled for: -w'<vv>v'
+ if(DBG()(3)) DOUT() << endl;
 }
 
 
 
-void Jtc::process_offsets_(deque<deq_jit> &wpi, vector<vector<signed_size_t>> &fom,
-                           size_t longest_walk, vector<size_t> &actuals) {
+Jtc::Grouping Jtc::process_offsets_(vector<vector<signed_size_t>> &fom,
+                                    size_t longest_walk, vector<size_t> &actuals) {
  #include "lib/dbgflow.hpp"
- // scans each offset's row (in wpi) and prints actual (non-empty) and relevant elements
+ // scans each offset's row (in fom) and leaves actual (non-empty) and relevant elements, the
+ // first one is to be given to the subscriber with the returned grouping
  DBG(2) DOUT() << "walk offsets (longest " << longest_walk << ")";
 
  size_t grouping = 0,                                           // group size (of lowest offsets)
@@ -2776,13 +3940,11 @@ void Jtc::process_offsets_(deque<deq_jit> &wpi, vector<vector<signed_size_t>> &f
  }
 
  if(DBG()(2)) DOUT() << endl;                                   // close debug line
- if(actuals.empty())                                            // should never be the case
-  { wpi.clear(); return; }                                      // in case, avoiding endless loop
+ if(actuals.empty()) return {};                                 // should never be the case
  DBG(2) DOUT() << "output instance: " << actuals.front()
                << ", #lowest offsets/counter: {" << grouping << ", "
                << (lf_counter == SIZE_T(-1)? "lowest": to_string(lf_counter)) << "}" << endl;
- (this->*subscriber_)(wpi[actuals.front()].front(), {grouping, lf_counter});
- wpi[actuals.front()].pop_front();
+ return {grouping, lf_counter};
 }
 
 
@@ -2804,30 +3966,30 @@ void Jtc::console_output_(Json::iterator &wi, Json &jtmp_, Grouping) {
  // 3. if -ll given then and conditions met (glean_lbls), then either 1. or 2. to be iterated
  auto & src = jtmp_.type() == Jnode::Neither? *wi: jtmp_.root();
  bool glean_lbls{glean_lbls_ and src.is_object() and src.has_children()};
- Jtc::mod_ |= ios_base::app;                                    // next time will append
+ if(write_to_file_) Jtc::mod_ |= ios_base::app;                 // next time will append
  size_t size{0};
 
  if(size_only_)                                                 // -zz
-  { xout_ << wi->size() << endl; return; }
+  { jout_wr_ << wi->size() << CHR_NLNE; return; }
 
  Jnode dummy = ARY{nullptr};
  for(auto itl = (glean_lbls? src: dummy).begin(); itl != (glean_lbls? src: dummy).end(); ++itl) {
   auto & srr = glean_lbls? *itl: src;                           // source reference
 
   if(opt()[CHR(OPT_LBL)] and srr.has_label())                   // -l given then print label
-   { xout_ << CHR_DQTE << srr.label() << CHR_DQTE << ": "; unquote_ = false; }  // if present
+   { jout_wr_ << CHR_DQTE << srr.label() << CHR_DQTE << ": "; unquote_ = false; }   // if present
   if(unquote_ and srr.is_string())                               // don't try collapsing it into
-   { if(not srr.str().empty()) xout_ << json().unquote_str(srr.str()) << endl; }
+   { if(not srr.str().empty()) jout_wr_ << json().unquote_str(srr.str()) << CHR_NLNE; }
   else {
    if(inquote_)
-    xout_ << CHR_DQTE << json().inquote_str(srr.to_string(Jnode::Raw)) << CHR_DQTE << endl;
-   else xout_ << srr << endl;                                    // a single operation!
+    jout_wr_.put(CHR_DQTE).inquote(srr.to_string(Jnode::Raw)) << CHR_DQTE << CHR_NLNE;
+   else jout_wr_ << srr << CHR_NLNE;                             // a single operation!
   }
   if(measure_) size += srr.size();
  }
 
  if(measure_)                                                    // -z given
-  xout_ << OBJ{LBL{JTCS_TKN, static_cast<double>(size)}} << endl;
+  jout_wr_ << OBJ{LBL{JTCS_TKN, static_cast<double>(size)}} << CHR_NLNE;
 }
 
 
@@ -2886,6 +4048,8 @@ void Jtc::jsonized_output_ary_(Json::iterator &wi, Json &jtmp, Grouping grp) {
  for(auto itl = (glean_lbls? src: dummy).begin(); itl != (glean_lbls? src: dummy).end(); ++itl) {
   auto & srr = glean_lbls? *itl: src;                           // source reference
 
+  if(stream_ary_)                                               // -l not given and no need to
+   { jout_wr_.array_element(srr); continue; }                   // retain jout_: stream element
   if(not opt()[CHR(OPT_LBL)])                                   // -l not given, make simple array
    { jout_.push_back(srr); continue; }
                                                                 // -l given (combine relevant grp)
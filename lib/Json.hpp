@@ -218,6 +218,11 @@
  * 5. Other methods.
  *      to_string()     // returns Json/Jnode converted to std::string
  *
+ *  for bulk outputs a buffered serializer Jwriter is available:
+ *      Jwriter jw(std::cout);
+ *      jw << json << '\n';     // output is passed to the stream in full blocks
+ *      jw.flush();             // drain remaining buffer and flush the stream
+ *
  *  there are a few methods to validate a Json node type:
  *      type()          // return Jnode::Jtype enum
  *      is_object()
@@ -378,6 +383,24 @@
  *   'keep_cache' keyword explicitly (at least the decision is conscious)
  *   CAUTION: Keeping the search cache after JSON has been modified may lead to
  *            undefined behavior.
+ *   The search cache could be bounded: once its (estimated) footprint exceeds the limit
+ *   set with search_cache_limit(bytes), least recently used cached searches are evicted
+ *   (down to 3/4 of the limit) and get rebuilt when searched again; the cache being used
+ *   is never evicted. By default (SRCH_CACHE_MAX, 0) the cache is unlimited: a limit
+ *   lower than the caches of interleaved walks makes them evict each other, i.e. rebuilt
+ *   over and over. The cache (and its limit) is not copied: a copy of Json starts with
+ *   an empty cache and the default limit
+ *
+ *  d) recursive label searches (<..>l, <..>L, [..]:<..>) and exact value searches
+ *   (<..>, <..>d, <..>b, <..>n) could be served off a document-wide index instead of
+ *   traversing subtrees: it's engaged with search_index() and built lazily upon the
+ *   first such search (label and value parts separately); the index is a part of the
+ *   search cache (i.e. it's invalidated together with the cache)
+ *
+ *  e) RE matches (<..>R, <..>D, <..>L) save their captures into the namespace ($0..$n
+ *   and $@); if nothing refers to those, captures could be disabled with
+ *   re_captures(false): then a match is found by the fast RE engine alone (captures
+ *   require std::regex); setting is copied along with Json, changing it clears the cache
  *
  *
  *  Some examples:
@@ -461,7 +484,10 @@
 #include <exception>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <set>
+#include <deque>
+#include <memory>               // std::shared_ptr
 #include <string>
 #include <functional>           // function objects
 #include <sstream>              // std::stringstream
@@ -475,11 +501,17 @@
 #include <cstddef>
 #include <bitset>
 #include <tuple>
+#include <cstring>              // strlen, memcpy
+#include <cstdint>              // uint64_t
+#include <atomic>
+#include <mutex>
 #include <unistd.h>             // for STDOUT_FILENO - for term width
 #include "extensions.hpp"
 #include "dbg.hpp"
 #include "Outable.hpp"
+#include "ThreadMaster.hpp"
 #include "Streamstr.hpp"
+#include "Regex.hpp"
 //#include "Blob.hpp"             // SERDES interface (not needed so far)
 
 
@@ -501,6 +533,10 @@
 #define ARRAY_LMT 4                                             // #bytes per array's index
 #define WLK_SUCCESS LONG_MIN                                    // walk() uses it as success
 #define WLK_MAXLOOPCNT 100000                                   // max default for <>f .. ><f loops
+#define SRCH_PRTMIN 64                                          // min children to partition search
+#define RE_CACHE_MAX 1024                                       // max compiled REs kept cached
+#define SRCH_CACHE_MAX 0UL                                      // default search caches limit
+#define SRCH_SIGS_MAX 65536                                     // max interned ws signatures
 #define KEY first                                               // semantic for map's pair
 #define VALUE second                                            // instead of first/second
 #define SIZE_T(N) static_cast<size_t>(N)
@@ -572,6 +608,97 @@
 #define ITRP_PSTR "$path"                                       // token for stringified path
 #define ITRP_WUID "$wuid"                                       // auto token for unique walk id
 
+#define JWR_BLKSZ (64 * 1024)                                   // Jwriter's output block size
+#define JWR_TABSZ 256                                           // size of precomputed indent table
+
+
+
+
+
+class Jnode;
+//
+//                      Jwriter class
+//
+//  o a buffered serializer of Jnode: all tokens are accumulated in a reusable byte buffer
+//    and passed over to the sink (ostream) only in full blocks, i.e. bypassing a formatted
+//    ostream insertion per token
+//  o blocks are passed with ostream::write() (not fwrite()/write(2)): sinks are not only cout,
+//    but also -f file, in-memory streams and relaying stream buffers, and outputs have to stay
+//    in order with other ostream outputs; a full block goes right into the stream buffer anyway
+//  o when no sink given, accumulated buffer is available via str() (used by to_string())
+//  o indentations are copied from a precomputed table of blanks
+//  o printing format (Jnode's global one) is picked up at the start of each Jnode output and
+//    then kept by the writer itself, thus alternating it (e.g., semi-compact printing, or
+//    to_string() in a certain format) does not touch the global format (concurrency safe)
+//  o a top-level array could be streamed element by element (open_array(), array_element(),
+//    close_array()) producing the same output as the whole array would (except semi-compact
+//    format, which requires all the children to be known upfront)
+//
+class Jwriter {
+    friend class Jnode;                                         // printing uses writer's format
+
+ public:
+                        Jwriter(void) = default;                // string mode (no sink)
+                        Jwriter(std::ostream &os): os_{&os} {}  // block writes into os
+                        Jwriter(const Jwriter &) = delete;
+                        ~Jwriter(void) { drain(); }
+
+    Jwriter &           put(char c) { buf_.push_back(c); return may_drain_(); }
+    Jwriter &           write(const char *s, size_t n) { buf_.append(s, n); return may_drain_(); }
+    Jwriter &           indent(size_t n) {                      // output n blanks
+                         static const std::string blanks(JWR_TABSZ, ' ');
+                         for(size_t c = 0; n > 0; n -= c)
+                          { c = std::min(n, blanks.size()); buf_.append(blanks.data(), c); }
+                         return may_drain_();
+                        }
+
+    Jwriter &           operator<<(char c) { return put(c); }
+    Jwriter &           operator<<(const char *s) { return write(s, strlen(s)); }
+    Jwriter &           operator<<(const std::string &s) { return write(s.data(), s.size()); }
+    Jwriter &           operator<<(size_t x) { return *this << std::to_string(x); }
+    Jwriter &           operator<<(const Jnode &jn);
+    Jwriter &           inquote(const char *s, size_t n);       // write with '"', '\' quoted
+    Jwriter &           inquote(const std::string &s) { return inquote(s.data(), s.size()); }
+
+    Jwriter &           open_array(void)                        // stream array elements ('['
+                         { aes_ = 0; return *this; }            // is deferred until 1st one)
+    Jwriter &           array_element(const Jnode &jn);
+    Jwriter &           close_array(void);
+    size_t              array_elements(void) const { return aes_; }
+    Jwriter &           format(const std::string &endl, size_t tab, bool sc) {   // fix format
+                         endl_ = endl; tab_ = tab; sc_ = sc; fixed_ = true;  // (otherwise Jnode's
+                         return *this;                          // global format is used)
+                        }
+
+    static const char * find_quotable(const char *b, const char *e);
+
+    Jwriter &           drain(void) { return drain_(buf_.size()); }  // pass all to the sink
+    Jwriter &           flush(void)                             // drain and flush the sink
+                         { drain(); if(os_) os_->flush(); return *this; }
+    std::string &       str(void) { return buf_; }              // string mode accessor
+
+ private:
+    std::ostream *      os_{nullptr};                           // sink, nullptr - string mode
+    std::string         buf_;                                   // reusable output buffer
+    size_t              aes_{0};                                // streamed array elements
+    bool                fixed_{false};                          // format is fixed, see format()
+    std::string         endl_;                                  // format in use: line separator,
+    size_t              tab_{0};                                // indent size,
+    bool                sc_{false};                             // and semi-compact printing
+
+    Jwriter &           sync_format_(void);                     // pick Jnode's global format
+
+    Jwriter &           drain_(size_t n) {                      // pass n bytes over to the sink
+                         if(os_ == nullptr or n == 0) return *this;
+                         os_->write(buf_.data(), n);
+                         buf_.erase(0, n);                      // retain capacity for reuse
+                         return *this;
+                        }
+    Jwriter &           may_drain_(void)                        // write full blocks only
+                         { return buf_.size() < JWR_BLKSZ? *this:
+                                   drain_(buf_.size() / JWR_BLKSZ * JWR_BLKSZ); }
+};
+
 
 
 
@@ -587,8 +714,10 @@ class Json;
 class Jnode {
     friend class Json;
 
+    friend class Jwriter;
+
   friend std::ostream & operator<<(std::ostream & os, const Jnode & jnode)
-                         { signed_size_t rl{0}; return print_json_(os, jnode, rl); }
+                         { Jwriter jw{os}; jw << jnode; return os; }
 
     friend void         swap(Jnode &l, Jnode &r) {
                          using std::swap;                       // enable ADL
@@ -812,13 +941,11 @@ class Jnode {
                         // class interface:
     std::string         to_string(PrettyType pt = PrettyType::Pretty,
                                   signed_size_t t = -1, bool sc = false) const {
-                         GUARD(Jnode::endl_);
-                         GUARD(Jnode::tab_);
-                         GUARD(Jnode::semicompact_);
-                         if(t >= 0) Jnode::tab(t);
-                         std::stringstream ss;
-                         ss << pretty(pt == PrettyType::Pretty).semicompact(sc);
-                         return ss.str();
+                         size_t tab = t >= 0? t: tab_;         // global format intact
+                         Jwriter jw;
+                         jw.format(pt == PrettyType::Pretty? PRINT_PRT: std::string(tab, PRINT_RAW),
+                                   tab, sc) << *this;
+                         return std::move(jw.str());
                         }
 
     Jtype               type(void) const { return value().type_; }
@@ -1034,43 +1161,39 @@ class Jnode {
                         // global setting
     bool                is_merging(void) const
                          { return clashing_labels_ == ClashingLabels::Merge; }
-    Jnode &             merge_clashing(bool x = true) {
-                         clashing_labels_ = x? ClashingLabels::Merge: ClashingLabels::Override;
-                         return *this;
-                        }
-    const Jnode &       merge_clashing(bool x = true) const {
-                         clashing_labels_ = x? ClashingLabels::Merge: ClashingLabels::Override;
-                         return *this;
-                        }
+    Jnode &             merge_clashing(bool x = true)
+                         { set_(clashing_labels_, x? ClashingLabels::Merge: ClashingLabels::Override);
+                           return *this; }
+    const Jnode &       merge_clashing(bool x = true) const
+                         { set_(clashing_labels_, x? ClashingLabels::Merge: ClashingLabels::Override);
+                           return *this; }
     bool                is_overriding(void) const
                          { return clashing_labels_ == ClashingLabels::Override; }
-    Jnode &             override_clashing(bool x = true) {
-                         clashing_labels_ = x? ClashingLabels::Override: ClashingLabels::Merge;
-                         return *this;
-                        }
-    const Jnode &       override_clashing(bool x = true) const {
-                         clashing_labels_ = x? ClashingLabels::Override: ClashingLabels::Merge;
-                         return *this;
-                        }
+    Jnode &             override_clashing(bool x = true)
+                         { set_(clashing_labels_, x? ClashingLabels::Override: ClashingLabels::Merge);
+                           return *this; }
+    const Jnode &       override_clashing(bool x = true) const
+                         { set_(clashing_labels_, x? ClashingLabels::Override: ClashingLabels::Merge);
+                           return *this; }
 
     bool                is_pretty(void) const { return endl_ == PRINT_PRT; }
     Jnode &             pretty(bool x = true)
-                         { endl_ = x? PRINT_PRT: std::string(tab(), PRINT_RAW); return *this; }
+                         { set_(endl_, x? PRINT_PRT: std::string(tab(), PRINT_RAW)); return *this; }
     const Jnode &       pretty(bool x = true) const
-                         { endl_ = x? PRINT_PRT: std::string(tab(), PRINT_RAW); return *this; }
+                         { set_(endl_, x? PRINT_PRT: std::string(tab(), PRINT_RAW)); return *this; }
     bool                is_raw(void) const { return endl_ != PRINT_PRT; }
     Jnode &             raw(bool x = true)
-                         { endl_ = x? std::string(tab(), PRINT_RAW): PRINT_PRT; return *this; }
+                         { set_(endl_, x? std::string(tab(), PRINT_RAW): PRINT_PRT); return *this; }
     const Jnode &       raw(bool x = true) const
-                         { endl_ = x? std::string(tab(), PRINT_RAW): PRINT_PRT; return *this; }
+                         { set_(endl_, x? std::string(tab(), PRINT_RAW): PRINT_PRT); return *this; }
     size_t              tab(void) const { return tab_; }
-    Jnode &             tab(size_t n) { tab_ = n; return *this; }
-    const Jnode &       tab(size_t n) const { tab_ = n; return *this; }
+    Jnode &             tab(size_t n) { set_(tab_, n); return *this; }
+    const Jnode &       tab(size_t n) const { set_(tab_, n); return *this; }
     bool                is_semicompact(void) const { return semicompact_; }
     Jnode &             semicompact(bool x = true)
-                         { semicompact_ = x; return *this; }
+                         { set_(semicompact_, x); return *this; }
     const Jnode &       semicompact(bool x = true) const
-                         { semicompact_ = x; return *this; }
+                         { set_(semicompact_, x); return *this; }
 
     //SERDES(type_, value_, descendants_)                       // not really needed yet
     #ifdef BG_CC                                                // if -DBG_CC is given, otherwise
@@ -1099,8 +1222,13 @@ class Jnode {
     map_jn              descendants_;                           // array/dictionary
 
  private:
-  static std::ostream & print_json_(std::ostream & os, const Jnode & me, signed_size_t & rl);
-  static std::ostream & print_iterables_(std::ostream & os, const Jnode & me, signed_size_t & rl);
+    static Jwriter &    print_json_(Jwriter & jw, const Jnode & me, signed_size_t & rl);
+    static Jwriter &    print_iterables_(Jwriter & jw, const Jnode & me, signed_size_t & rl);
+
+    template<typename T>                                        // global settings are written
+    static void         set_(T &var, const T &val)              // only when changed: reapplying
+                         { if(not (var == val)) var = val; }    // the same format is concurrency
+                                                                // safe, a different one is not
 
     static Jnode::ClashingLabels
                         clashing_labels_;
@@ -1570,75 +1698,152 @@ std::string Jnode::next_key_(void) const {
 
 
 
-std::ostream & Jnode::print_json_(std::ostream & os, const Jnode & me, signed_size_t & rl) {
- // output Jnode to `os`
+Jwriter & Jnode::print_json_(Jwriter & jw, const Jnode & me, signed_size_t & rl) {
+ // output Jnode to the writer `jw`
  auto & my = me.value();                                        // resolve if virtual object
  auto sc_print =
   [&] {                                                         // semi-compact print
-   if(not semicompact_) return false;
+   if(not jw.sc_) return false;
    if(std::any_of(my.children_().begin(), my.children_().end(),
                   [](const auto &j){ return j.VALUE.is_iterable() and j.VALUE.has_children(); } ))
     return false;
-   GUARD(Jnode::endl_)                                          // facilitate semi-compact printing
-   GUARD(Jnode::tab_)
-   my.tab(1).raw();
-   os << endl_;
+   GUARD(jw.endl_)                                              // facilitate semi-compact printing
+   GUARD(jw.tab_)
+   jw.tab_ = 1;
+   jw.endl_ = std::string(jw.tab_, PRINT_RAW);
+   jw << jw.endl_;
    signed_size_t rl{0};
-   print_iterables_(os, my, rl);
+   print_iterables_(jw, my, rl);
    return true;
   };
  switch(my.type()) {
   case Jtype::Object:
-        os << JSN_OBJ_OPN;
-        if(my.is_empty()) return os << JSN_OBJ_CLS;
-        if(sc_print()) return os;
-        os << endl_;
+        jw << JSN_OBJ_OPN;
+        if(my.is_empty()) return jw << JSN_OBJ_CLS;
+        if(sc_print()) return jw;
+        jw << jw.endl_;
         break;
   case Jtype::Array:
-        os << JSN_ARY_OPN;
-        if(my.is_empty()) return os << JSN_ARY_CLS;
-        if(sc_print()) return os;
-        os << endl_;
+        jw << JSN_ARY_OPN;
+        if(my.is_empty()) return jw << JSN_ARY_CLS;
+        if(sc_print()) return jw;
+        jw << jw.endl_;
         break;
   case Jtype::Bool:
-        return os << (my.bul()? STR_TRUE: STR_FALSE);
+        return jw << (my.bul()? STR_TRUE: STR_FALSE);
   case Jtype::Null:
-        return os << STR_NULL;
+        return jw << STR_NULL;
   case Jtype::Number:
-        return os << my.val();
+        return jw << my.val();
   case Jtype::String:
-        return os << JSN_STRQ << my.str() << JSN_STRQ;
+        return jw << JSN_STRQ << my.str() << JSN_STRQ;
   default:                                                      // case Neither
         #ifdef BG_CC
-         return os;
+         return jw;
         #else
          throw me.EXP(ThrowReason::walk_a_bug);
         #endif
  }
- return print_iterables_(os, my, rl);
+ return print_iterables_(jw, my, rl);
 }
 
 
 
-std::ostream & Jnode::print_iterables_(std::ostream & os, const Jnode & my, signed_size_t & rl) {
+Jwriter & Jnode::print_iterables_(Jwriter & jw, const Jnode & my, signed_size_t & rl) {
  // process children in iterables (array or object)
- if(endl_ == PRINT_PRT) ++rl;                                   // if pretty print - adjust level
-
- for(auto & child: my.children_()) {                            // print all children:
-  os << std::string(rl * tab_, PRINT_RAW);                      // output current indent
-  if(my.is_object())                                            // if parent (me) is Object
-   os << JSN_STRQ << child.KEY << JSN_STRQ                      // print label
-      << LBL_SPR << (endl_.empty()? "":" ");                    // and separator
-  print_json_(os, child.VALUE, rl)                              // then print child itself and the
-   << (child.KEY != my.children_().rbegin()->KEY? ",": "")      // trailing comma if not the last
-   << endl_;
+ if(jw.endl_ == PRINT_PRT) ++rl;                                // if pretty print - adjust level
+
+ const auto & children = my.children_();
+ for(auto child = children.begin(); child != children.end();) { // print all children:
+  jw.indent(rl * jw.tab_);                                      // output current indent
+  if(my.is_object()) {                                          // if parent (me) is Object
+   jw << JSN_STRQ << child->KEY << JSN_STRQ << LBL_SPR;         // print label and separator
+   if(not jw.endl_.empty()) jw << PRINT_RAW;
+  }
+  print_json_(jw, child->VALUE, rl);                            // then print child itself and the
+  if(++child != children.end()) jw << JSN_VSPR;                 // trailing comma if not the last
+  jw << jw.endl_;
+ }
+
+ if(rl > 1) jw.indent((rl - 1) * jw.tab_);                      // would also signify pretty print
+ jw << (my.is_array()? JSN_ARY_CLS: JSN_OBJ_CLS);               // close array/object
+
+ if(jw.endl_ == PRINT_PRT) --rl;                                // if pretty print - adjust level
+ return jw;
+}
+
+
+
+Jwriter & Jwriter::sync_format_(void) {
+ // unless fixed, pick up Jnode's global format
+ if(fixed_) return *this;
+ if(endl_ != Jnode::endl_) endl_ = Jnode::endl_;
+ tab_ = Jnode::tab_;
+ sc_ = Jnode::semicompact_;
+ return *this;
+}
+
+
+
+Jwriter & Jwriter::operator<<(const Jnode &jn) {
+ // serialize Jnode into the buffer
+ Jnode::signed_size_t rl{0};
+ return Jnode::print_json_(sync_format_(), jn, rl);
+}
+
+
+
+Jwriter & Jwriter::array_element(const Jnode &jn) {
+ // serialize the next element of the streamed array (see print_iterables_)
+ sync_format_();
+ Jnode::signed_size_t rl{endl_ == PRINT_PRT? 1: 0};
+ *this << (aes_++ > 0? JSN_VSPR: JSN_ARY_OPN) << endl_;
+ indent(rl * tab_);
+ return Jnode::print_json_(*this, jn, rl);
+}
+
+
+
+Jwriter & Jwriter::close_array(void) {
+ // close the streamed array
+ sync_format_();
+ *this << (aes_ > 0? endl_: std::string(1, JSN_ARY_OPN));
+ return put(JSN_ARY_CLS);
+}
+
+
+
+Jwriter & Jwriter::inquote(const char *s, size_t n) {
+ // write string s quoting '"' and '\' chars, clean runs in between are copied in bulk
+ for(const char *e = s + n, *q = find_quotable(s, e); ; q = find_quotable(s, e)) {
+  buf_.append(s, q - s);
+  if(q == e) break;
+  buf_ += CHR_QUOT;
+  buf_ += *q;
+  s = q + 1;
  }
+ return may_drain_();
+}
+
 
- if(rl > 1) os << std::string((rl - 1) * tab_, PRINT_RAW);      // would also signify pretty print
- os << (my.is_array()? JSN_ARY_CLS: JSN_OBJ_CLS);               // close array/object
 
- if(endl_ == PRINT_PRT) --rl;                                   // if pretty print - adjust level
- return os;
+const char * Jwriter::find_quotable(const char *b, const char *e) {
+ // find first '"' or '\' in [b, e) or return e; the scan is word-at-a-time (SWAR): a zero byte in
+ // (w ^ pattern) flags a match; the lowest flagged byte is always exact (on little endian)
+ #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  const uint64_t ones{~0ULL / 0xFF}, highs{ones << 7};          // 0x0101.., 0x8080..
+  const uint64_t dqt{ones * JSN_STRQ}, bsl{ones * CHR_QUOT};
+  auto zero_bytes = [&](uint64_t v) { return (v - ones) & ~v & highs; };
+
+  for(uint64_t w; e - b >= static_cast<ptrdiff_t>(sizeof(w)); b += sizeof(w)) {
+   memcpy(&w, b, sizeof(w));
+   uint64_t m = zero_bytes(w ^ dqt) | zero_bytes(w ^ bsl);
+   if(m != 0) return b + (__builtin_ctzll(m) >> 3);
+  }
+ #endif
+ for(; b != e; ++b)                                             // the tail (or big endian)
+  if(*b == JSN_STRQ or *b == CHR_QUOT) break;
+ return b;
 }
 
 
@@ -1657,6 +1862,8 @@ std::ostream & Jnode::print_iterables_(std::ostream & os, const Jnode & my, sign
 class Json {
     friend std::ostream & operator<<(std::ostream & os, const Json & my)
                            { return os << my.root(); }
+    friend Jwriter &    operator<<(Jwriter & jw, const Json & my)
+                           { return jw << my.root(); }
 
     #define PARSE_THROW /* used in parsing, parse_range_, validate_number_, parse_index_ */ \
                 May_throw, \
@@ -1778,8 +1985,12 @@ class Json {
                         Json(const char *c_str) { parse( std::string{c_str} ); }
 
     // class interface:
-    Jnode &             root(void) { return root_; }
-    const Jnode &       root(void) const { return root_; }
+    Jnode &             root(void) { return srp_? *srp_: root_; }
+    const Jnode &       root(void) const { return srp_? *srp_: root_; }
+    Json &              share_root(Json & j)                    // walk j's tree (which must outlive
+                         { srp_ = &j.root(); return *this; }    // this one) with own ns and caches
+    static void         search_pool(ThreadMaster *tm)           // pool to partition recursive
+                         { stm_ = tm; }                         // searches over (see research_())
 
     // parsing methods
     // - Why parsing is in Json and not in Jnode class?
@@ -1912,7 +2123,20 @@ class Json {
                          quotedsolidus_ = quote;
                          return *this;
                         }
-    Json &              clear_cache(void) { srchc_.clear(); sortc_.clear(); return *this; }
+    Json &              clear_cache(void)
+                         { reset_cache_(); srchi_.clear(); return *this; }
+    size_t              search_cache_limit(void) const { return cst_.limit; }
+    Json &              search_cache_limit(size_t bytes)        // bound (estimated) footprint of
+                         { cst_.limit = bytes; trim_cache_(); return *this; }   // search caches
+    bool                is_re_captured(void) const { return captured_; }
+    Json &              re_captures(bool x = true) {            // RE matches fill $0..$n, $@ ns
+                         if(x != captured_) clear_cache();      // cached matches lack captures
+                         captured_ = x;
+                         return *this;
+                        }
+    bool                is_search_indexed(void) const { return indexed_; }
+    Json &              search_index(bool x = true)             // engage index for recursive
+                         { indexed_ = x; srchi_.clear(); return *this; }    // lbl/value searches
     map_jne &           ns(void) { return jns_; }               // namespace
     const map_jne &     ns(void) const { return jns_; }         // const namespace
                         // use ns(key) form only for an access, for write use ns()[key] instead,
@@ -1939,6 +2163,7 @@ class Json {
  protected:
     // protected data structures
     Jnode               root_;                                  // underlying JSON structure
+    Jnode *             srp_{nullptr};                          // shared root (see share_root())
     Streamstr::const_iterator
                         exp_;                                   // exception pointer
     Jnode::ThrowReason  exr_{Jnode::ThrowReason::start_of_json_parsing_exceptions}; // excp. reason
@@ -1986,7 +2211,9 @@ class Json {
     std::string         extract_lexeme_(std::string::const_iterator &si, char closing) const;
     void                parse_suffix_(std::string::const_iterator &, iterator &, vec_str&) const;
     void                parse_user_json_(WalkStep &ws) const;
-  std::regex::flag_type parse_RE_flags_(std::string & re_str) const;
+  std::regex::flag_type parse_RE_flags_(std::string & re_str, Regex::Engine & eng) const;
+    std::shared_ptr<const Regex>
+                        compile_RE_(const std::string & re_str) const;
     Jsearch             search_suffix_(char sfx) const;
     void                parse_quantifier_(std::string::const_iterator &si, iterator & it) const ;
     void                parse_range_(std::string::const_iterator &, WalkStep &, ParseThrow) const;
@@ -2037,7 +2264,7 @@ class Json {
 
 
     // SearchCacheEntry:
-    // - used by SearchCache: preserves a path for a found search (and its current namespace)
+    // - used by SearchPaths: a path being searched (and its current namespace)
     struct SearchCacheEntry {
         // namespace at the given instance of the path, to support its REGEX values
         friend SWAP(SearchCacheEntry, ns, pv)
@@ -2053,6 +2280,68 @@ class Json {
     };
 
 
+    // SearchPaths:
+    // - used by SearchCache: preserves all found paths for a search (and their namespaces)
+    struct SearchPaths {
+        // found paths are stored as a prefix tree of node handles (each node refers to its
+        // parent), so paths found in the same subtree share the common prefix; a path is
+        // rebuilt on demand: labels and node addresses required for validation are restored
+        // off the iterators (the cache is only valid for unmodified JSON anyway)
+        // back() is the working entry (a path being searched), it's not counted in size()
+        struct Node {
+            Jnode::iter_jn      jit;                            // iterator pointing to JSON node
+            size_t              parent;                         // parent node pos + 1 (0: none)
+        };
+
+        size_t              size(void) const { return tails.size(); }
+        SearchCacheEntry &  back(void) { return work; }
+        const SearchCacheEntry &
+                            back(void) const { return work; }
+        void                reset(void) { work.pv.clear(); work.ns.clear(); }
+        void                cache_in(void) {                    // cache-in the working entry
+                             size_t k = 0;                      // reuse common prefix with the
+                             while(k < last.size() and k < work.pv.size() and   // last cached
+                                   nodes[last[k]].jit == work.pv[k].jit) ++k;   // path
+                             last.resize(k);
+                             for(; k < work.pv.size(); ++k) {
+                              nodes.push_back(Node{work.pv[k].jit, k == 0? 0: last.back() + 1});
+                              last.push_back(nodes.size() - 1);
+                             }
+                             if(not work.ns.empty())            // ns is required only after
+                              { ns.emplace(size(), std::move(work.ns)); work.ns.clear(); } // REs
+                             tails.push_back(last.empty()? 0: last.back() + 1);
+                            }
+        void                append(SearchPaths && sp) {         // append other's cached paths
+                             size_t base = nodes.size(), at = size();
+                             for(auto &n: sp.nodes)
+                              nodes.push_back(Node{n.jit, n.parent == 0? 0: n.parent + base});
+                             for(auto t: sp.tails) tails.push_back(t == 0? 0: t + base);
+                             for(auto &e: sp.ns) ns.emplace(e.KEY + at, std::move(e.VALUE));
+                             last.clear();
+                            }
+        void                path(size_t idx, path_vector &pv) const {   // augment pv with
+                             size_t from = pv.size();                   // idx'th cached path
+                             for(size_t n = tails[idx]; n != 0; n = nodes[n - 1].parent)
+                              pv.emplace_back(nodes[n - 1].jit);
+                             std::reverse(pv.begin() + from, pv.end());
+                            }
+        const Jnode *       jnp(size_t idx) const               // found node (null: empty path)
+                             { return tails[idx] == 0? nullptr: &nodes[tails[idx] - 1].jit->VALUE; }
+        const map_jne &     namespc(size_t idx) const {
+                             static const map_jne empty;
+                             auto found = ns.find(idx);
+                             return found == ns.end()? empty: found->VALUE;
+                            }
+
+        std::vector<Node>   nodes;                              // prefix tree of found paths
+        std::vector<size_t> tails;                              // last node pos + 1 of each path
+        std::unordered_map<size_t, map_jne>
+                            ns;                                 // ns of cached paths (if any)
+        std::vector<size_t> last;                               // nodes of the last cached path
+        SearchCacheEntry    work;                               // working entry
+    };
+
+
     struct Gremap {
         // facilitate entries being sorted in SortCacheEntry
         friend SWAP(Gremap, jnp, ord);
@@ -2084,6 +2373,11 @@ class Json {
         std::set<Gremap, decltype(&Gremap::cmp)>
                             sortset{Gremap::cmp};               // sorted  jnodes (w. ordinal idx)
         std::vector<size_t> offsetmap;                          // remap encounter idx->sorted idx
+        size_t              used{0};                            // tick of last use (for LRU)
+
+        size_t              bytes(void) const                   // estimated footprint
+                             { return sizeof(*this) + sortset.size() * (sizeof(Gremap) +
+                                      4 * sizeof(void*)) + offsetmap.capacity() * sizeof(size_t); }
     };
 
 
@@ -2094,8 +2388,8 @@ class Json {
         // walk path is made of walk steps instructing how JSON tree to be traversed
         friend SWAP(WalkStep, jsearch, type,
                               offset_val, head_val, tail_val, step_val,
-                              offset_str, head_str, tail_str, step_str,
-                              lexeme, stripped, rexp, user_json, locked, wsuid, fs_path)
+                              txt, rexp, user_json, locked, wsuid, fs_path,
+                              op, trait, sigid, siggen, intp_done)
 
         #define WALKSTEPTYPE    /* walk types for subscripts only - irrelevant in searches */\
             Static_select,      /* [3], [0], quantifier: 0, 3, etc */ \
@@ -2103,8 +2397,7 @@ class Json {
             Root_select,        /* [^5], quantifier: NA */ \
             Range_walk,         /* [+0], [1:], [4:10], [-5:-1], quantifiers: +0, 3:, 4:10 */ \
             Directive,          /* this is used for directives only */ \
-            Inactive,           /* this is used to deactivate directives */ \
-            Cache_complete      /* this is used in **CacheKey** only */
+            Inactive            /* this is used to deactivate directives */
                                 // Note: there's no negative range for iterable quantifier: no way
                                 // to know upfront the number of hits a recursive search'd produce
             // Some directives [ZzWvkI] can be either active (WsType == Directive), or inactive
@@ -2115,17 +2408,47 @@ class Json {
             // are getting re-activated
         ENUMSTC(WsType, WALKSTEPTYPE)
 
+        #define WALKSTEPOP      /* dispatch target of the walk step, resolved in compile() */\
+            Op_numeric_offset,  /* [3], [-1], [^2], [+0], [1:] */ \
+            Op_text_offset,     /* [abc] */ \
+            Op_search,          /* <..>, >..< (except directives) */ \
+            Op_directive        /* <..>k, <..>f, etc */
+        ENUM(WsOp, WALKSTEPOP)
+        #undef WALKSTEPOP
+
+        #define WALKSTEPTRAIT   /* index semantics for bitset of compiled walk step traits */ \
+            Recursive,          /* <..> */ \
+            Lbl_based,          /* operates on labels: l, L, t */ \
+            Qnt_relative,       /* >..<t, >..<l, <..>I */ \
+            Cacheless,          /* searches which are not cached */ \
+            Ns_resolution,      /* lexeme requires resolution from ns before a search */ \
+            Ns_saving,          /* walked JSON is saved into ns (see maybe_nsave_) */ \
+            Query,              /* <..>q, <..>Q: sort cache is per walk */ \
+            Sorting,            /* <..>g, <..>G: cached idx is remapped */ \
+            Re_constant,        /* <..>R, <..>D, <..>L w/o interpolation tokens */ \
+            Size
+        ENUM(WsTrait, WALKSTEPTRAIT)
+        #undef WALKSTEPTRAIT
+
                             WalkStep(void):                         // DC
-                             wsuid{Json::iterator::uuid_++} {}
+                             txt{std::make_shared<WsText>()}, wsuid{Json::iterator::uuid_++} {}
                             WalkStep(const WalkStep &) = default;   // CC
                             WalkStep(WalkStep && ws) = default;     // MC
         WalkStep &          operator=(WalkStep ws) noexcept         // CA, MA
                              { swap(*this, ws); return *this; }
 
                             WalkStep(std::string && l, Jsearch js): // enable emplacement
-                             jsearch(js), lexeme(std::move(l)), wsuid{Json::iterator::uuid_++} {}
+                             jsearch(js), txt{std::make_shared<WsText>(WsText{std::move(l), {}})},
+                             wsuid{Json::iterator::uuid_++} {}
+
+        const std::string & lexeme(void) const { return txt->lexeme; }
+        const vec_str &     stripped(void) const { return txt->stripped; }
+        const std::string & offset_str(void) const { return txt->offset_str; }
+        const std::string & head_str(void) const { return txt->head_str; }
+        const std::string & tail_str(void) const { return txt->tail_str; }
+        const std::string & step_str(void) const { return txt->step_str; }
 
-        bool                operator<(const WalkStep &r) const {    // used only in CacheKey:
+        std::string         signature(void) const {                 // used only in CacheKey:
                              // CacheKey is the key of SearchCache. Even though WalkStep has a
                              // wsuid, which uniquely identifies walk step, CacheKey provides
                              // below differentiation logic (instead of basing on a simple wsuid)
@@ -2133,36 +2456,23 @@ class Json {
                              //  1) similar WS could be reused for cacheing purpose
                              //  2) original WalkStep (wsuid) might not even exist, while cache
                              //     still could be actual and hence reused
-                             // WS with json capturing properties must be considered as empty
-                             if(is_subscript() or r.is_subscript())
-                              return jsearch < r.jsearch;
-
-                             static const std::string empty{};      // used for capturing lexemes
-                             std::vector<const std::string *> lptr{&stripped.front()},
-                                                              rptr{&r.stripped.front()};
-                             lptr.push_back(stripped.size() > 1? &stripped.back(): &empty);
-                             rptr.push_back(r.stripped.size() > 1? &r.stripped.back(): &empty);
-                             if(is_json_capturing_lexeme()) lptr.front() = &empty;
-                             if(r.is_json_capturing_lexeme()) rptr.front() = &empty;
-
-                             return jsearch != r.jsearch?       // for caching purpose quantifiers
-                                     jsearch < r.jsearch:       // are not considered
-                                     is_user_json_search()?
-                                      ( user_json != r.user_json?
-                                         user_json < r.user_json:
-                                         *lptr.back() < *rptr.back()
-                                      ):
-                                      is_regex()?
-                                       // regex match uses user_json as a str value and user_json
-                                       // type as a flag for interpolation, thus using val()
-                                       ( user_json.val() != r.user_json.val()?
-                                          user_json.val() < r.user_json.val():
-                                          *lptr.back() < *rptr.back()
-                                       ):
-                                       ( *lptr.front() != *rptr.front()?
-                                          *lptr.front() < *rptr.front():
-                                          *lptr.back() < *rptr.back()
-                                       );
+                             // WS with json capturing properties must be considered as empty;
+                             // for caching purpose quantifiers are not considered
+                             std::string sig{std::to_string(jsearch)};
+                             if(is_subscript()) return sig;
+
+                             std::string lxm = is_user_json_search()?
+                                                (user_json.is_neither()?
+                                                  "": user_json.to_string(Jnode::Raw, 0)):
+                                               is_regex()?
+                                                // regex match uses user_json as a str value and
+                                                // type as a flag for interpolation, thus val()
+                                                user_json.val():
+                                               is_json_capturing_lexeme()?
+                                                "": stripped().front();
+                             sig += ':' + std::to_string(lxm.size()) + ':' + lxm;
+                             if(stripped().size() > 1) sig += stripped().back();
+                             return sig;
                             }
         bool                resolve_ns(Json::iterator &jit) {
                              // resolve namespace value for dynamic lexemes into user_json:
@@ -2171,7 +2481,7 @@ class Json {
                              switch(jsearch) {
                               case Jsearch::search_from_ns:
                               case Jsearch::tag_from_ns: {
-                                    const auto found = jsn.ns().find(stripped.front());
+                                    const auto found = jsn.ns().find(stripped().front());
                                     if(found == jsn.ns().end() or found->VALUE.ref().is_neither())
                                      throw jsn.EXP(Jnode::ThrowReason::walk_non_existant_namespace);
                                     user_json = found->VALUE.ref();
@@ -2179,7 +2489,7 @@ class Json {
                                    }
                               case Jsearch::json_match: {
                                     if(user_json.is_neither()) {    // i.e. it's a template
-                                     user_json = Json::interpolate(stripped.front(), jit);
+                                     user_json = Json::interpolate(stripped().front(), jit);
                                      if(user_json.is_neither())
                                       throw jsn.EXP(Jnode::ThrowReason::json_lexeme_invalid);
                                      return true;                   // ensure reset to Neither
@@ -2187,13 +2497,13 @@ class Json {
                                     // user_json is a valid JSON, but it still could be a template
                                     // if template was within a string. Try interpolating once
                                     // and see if there's a difference
-                                    if(not stripped.front().empty()) {
+                                    if(not intp_done and not stripped().front().empty()) {
                                      Jnode j = std::move(user_json);
-                                     user_json = Json::interpolate(stripped.front(), jit);
+                                     user_json = Json::interpolate(stripped().front(), jit);
                                       if(user_json.is_neither())
                                        throw jsn.EXP(Jnode::ThrowReason::json_lexeme_invalid);
                                      if(user_json != j) return true;// tmp: reset it to Neither
-                                     stripped.front().clear();      // indicate no intp. needed
+                                     intp_done = true;              // indicate no intp. needed
                                     }
                                     return false;                   // don't reset to Neither
                                    }
@@ -2202,12 +2512,15 @@ class Json {
                               case Jsearch::Label_RE_search: {
                                     // interpolation renders RE search slower, so use it
                                     // only if there is interpolation token in RE lexeme
+                                    if(is(WsTrait::Re_constant)) {  // RE is compiled only once
+                                     if(rexp) break;                // (user_json keeps RE string)
+                                     user_json = STR{stripped().front()};
+                                    }
                                     if(user_json.is_neither())      // request to interpolate
-                                     user_json = Json::interpolate(stripped.front(), jit, jsn.ns(),
-                                                                   Json::ParseTrailing::Dont_parse);
-                                    auto restr = user_json.val();   // copy is required here
-                                    rexp = std::regex(restr, jsn.parse_RE_flags_(restr));
-                                    if(user_json.val() == stripped.front())
+                                     user_json = Json::interpolate(stripped().front(), jit,
+                                                  jsn.ns(), Json::ParseTrailing::Dont_parse);
+                                    rexp = jsn.compile_RE_(user_json.val());
+                                    if(user_json.val() == stripped().front())
                                      { user_json.type(Jnode::Jtype::Neither); break; }
                                     // user_json will not be set to Neither => dont intp. next time
                                     else return true;
@@ -2220,9 +2533,9 @@ class Json {
 
         // various walk properties
         bool                is_recursive(void) const
-                             { return lexeme.front() == LXM_SCH_OPN; }
+                             { return lexeme().front() == LXM_SCH_OPN; }
         bool                is_non_recursive(void) const
-                             { return lexeme.front() == LXM_SCH_CLS; }
+                             { return lexeme().front() == LXM_SCH_CLS; }
         bool                is_regex(void) const
                              { return jsearch AMONG(Jsearch::Regex_search, Jsearch::Digital_regex,
                                                     Jsearch::Label_RE_search); }
@@ -2238,7 +2551,7 @@ class Json {
                              { return is_lexeme_dynamic() or jsearch == Jsearch::json_match; }
 
         bool                is_qnt_namespace_based(void) const
-                             { return not head_str.empty() or not tail_str.empty(); }
+                             { return not head_str().empty() or not tail_str().empty(); }
         bool                is_lbl_based(void) const            // operates on label types l/L/t
                              { return jsearch AMONG(Jsearch::label_match, Jsearch::Label_RE_search,
                                                     Jsearch::tag_from_ns); }
@@ -2253,7 +2566,7 @@ class Json {
         bool                is_cacheless(void) const
                              { return is_qnt_relative(); }
         bool                is_subscript(void) const
-                             { return lexeme.front() == LXM_SUB_OPN; }
+                             { return lexeme().front() == LXM_SUB_OPN; }
         bool                is_search(void) const
                              { return not is_subscript(); }
         bool                is_directive(void) const {
@@ -2280,8 +2593,8 @@ class Json {
                              // i.e. if lexeme suppose to preserve JSON into the namespace
                              // e.g.: <namespace>v, or <ns:user_json>v
                              if(jsearch == Jsearch::boolean_match)
-                              return stripped.front() == STR_TRUE? false:
-                                     stripped.front() == STR_FALSE? false:
+                              return stripped().front() == STR_TRUE? false:
+                                     stripped().front() == STR_FALSE? false:
                                      true;
                              return jsearch AMONG(Jsearch::null_match, Jsearch::atomic_match,
                                                   Jsearch::object_match, Jsearch::indexable_match,
@@ -2297,18 +2610,18 @@ class Json {
                                                  ); }
         signed_size_t       head(void) const { return head_val; }
         signed_size_t       head(const Json &j) const
-                             { return head_str.empty()? head_val: fetch_from_ns(head_str, j); }
+                             { return head_str().empty()? head_val: fetch_from_ns(head_str(), j); }
         signed_size_t       tail(void) const { return tail_val; }
         signed_size_t       tail(const Json &j) const
-                             { return tail_str.empty()? tail_val: fetch_from_ns(tail_str, j); }
+                             { return tail_str().empty()? tail_val: fetch_from_ns(tail_str(), j); }
         signed_size_t       step(void) const { return step_val; }
         signed_size_t       step(const Json &j) const
-                             { return step_str.empty()? step_val: fetch_from_ns(step_str, j); }
+                             { return step_str().empty()? step_val: fetch_from_ns(step_str(), j); }
         signed_size_t       offset(void) const { return offset_val; }
         signed_size_t       offset(const Json &j) const {
-                             if(offset_str.empty() or type == WsType::Range_walk)
+                             if(offset_str().empty() or type == WsType::Range_walk)
                               return offset_val;
-                             return fetch_from_ns(offset_str, j);
+                             return fetch_from_ns(offset_str(), j);
                             }
         signed_size_t       fetch_from_ns(const std::string &val, const Json &j) const {
                              const auto found = j.ns().find(val);
@@ -2325,6 +2638,31 @@ class Json {
                             }
         bool                is_locked(void) const { return locked; }
 
+        void                compile(void) {
+                             // lower parsed walk step into a dispatch target and a set of
+                             // traits, so that walking does not re-decide what kind of lexeme
+                             // it is for every walked node
+                             op = type >= WsType::Directive? WsOp::Op_directive:
+                                  is_search()? WsOp::Op_search:
+                                  jsearch == Jsearch::numeric_offset?
+                                   WsOp::Op_numeric_offset: WsOp::Op_text_offset;
+                             trait[WsTrait::Recursive] = is_recursive();
+                             trait[WsTrait::Lbl_based] = is_lbl_based();
+                             trait[WsTrait::Qnt_relative] = is_qnt_relative();
+                             trait[WsTrait::Cacheless] = is_cacheless();
+                             trait[WsTrait::Ns_resolution] = require_ns_resolution();
+                             trait[WsTrait::Ns_saving] = jsearch == Jsearch::Increment_num or
+                                                         (is_json_capturing_lexeme() and
+                                                          not stripped().front().empty());
+                             trait[WsTrait::Query] = jsearch AMONG(Jsearch::query_original,
+                                                                   Jsearch::Query_duplicate);
+                             trait[WsTrait::Sorting] = jsearch AMONG(Jsearch::go_ascending,
+                                                                     Jsearch::Go_descending);
+                             trait[WsTrait::Re_constant] = is_regex() and
+                                 stripped().front().find(ITRP_BRC[0]) == std::string::npos;
+                            }
+        bool                is(WsTrait t) const { return trait[t]; }
+
         // Walkstep data:
         Jsearch             jsearch;                            // Jsearch type (r/R/d/D/n/l/L etc)
         WsType              type{WsType::Static_select};        // lexeme's type (static/range/etc)
@@ -2332,20 +2670,33 @@ class Json {
         signed_size_t       head_val{0};                        // range walk type
         signed_size_t       tail_val{LONG_MAX};                 // by default - till the end
         signed_size_t       step_val{1};                        // increment step
-        std::string         offset_str;                         // interpolatable offset
-        std::string         head_str;                           // interpolatable head
-        std::string         tail_str;                           // interpolatable tail
-        std::string         step_str;                           // interpolatable step
-        std::string         lexeme;                             // lexeme w/o suffix and quantifier
-        vec_str             stripped;                           // stripped lexeme, + optional lbl
+        struct WsText {                                         // walk step's text: parsed once,
+            std::string         lexeme;                         // immutable once compiled, thus
+            vec_str             stripped;                       // shared by all copies of ws
+            std::string         offset_str;                     // interpolatable offset
+            std::string         head_str;                       // interpolatable head
+            std::string         tail_str;                       // interpolatable tail
+            std::string         step_str;                       // interpolatable step
+        };
+                            // lexeme: lexeme w/o suffix and quantifier
+                            // stripped: stripped lexeme, + optional lbl
                             // stripped[0] (always present): holds a stripped lexeme,
                             // or NS w/o initializer, or a expanded template value
                             // stripped[1]: attached label match (e.g.: [label]:<..>), if required
-        std::regex          rexp;                               // RE for R/L/D suffixes
+        std::shared_ptr<WsText>
+                            txt;                                // lexeme and stripped lexeme
+        std::shared_ptr<const Regex>
+                            rexp;                               // RE for R/L/D suffixes
         Jnode               user_json{Jnode::Jtype::Neither};   // for those allowing storing JSON
         bool                locked{false};                      // indicate locked/unlocked state
+        bool                intp_done{false};                   // <..>j: template is resolved
         unsigned short      wsuid;                              // unique walk-id for ws
         path_vector         fs_path;                            // preserved path for fail-safe
+        WsOp                op{WsOp::Op_search};                // compiled dispatch target
+        std::bitset<WsTrait::Size>
+                            trait;                              // compiled walk step traits
+        size_t              sigid{0};                           // interned signature (CacheKey)
+        size_t              siggen{0};                          // cache generation of sigid
         // fail_safe (<>f)/ Forward_itr (<>F) design notes:
         // 1. fail_safe (FS) <..>f and Forward_itr (FI) <..>F directives design:
         //  o lexemes may be found in 2 states: locked and unlocked
@@ -2430,7 +2781,7 @@ class Json {
         const char *        search_type() const
                              { return STRENM(Jsearch, jsearch); }
         const std::string   label() const
-                             { return stripped.size()==2? stripped.back(): "N/A"; }
+                             { return stripped().size()==2? stripped().back(): "N/A"; }
         std::string         json() const
                              { return user_json.is_neither()?
                                        "N/A": user_json.to_string(Jnode::PrettyType::Raw, 1); }
@@ -2440,65 +2791,114 @@ class Json {
         std::string         range() const {
                              if(type != WsType::Range_walk) return "N/A";
                              std::stringstream ss;
-                             ss << "[" << (head_str.empty()?
+                             ss << "[" << (head_str().empty()?
                                            head_val == 0? "": std::to_string(head_val):
-                                           "{" + head_str + "}") << ':'
-                                << (tail_str.empty()?
+                                           "{" + head_str() + "}") << ':'
+                                << (tail_str().empty()?
                                     tail_val == LONG_MAX? "": std::to_string(tail_val):
-                                    "{" + tail_str + "}")
-                                << (step_str.empty()?
+                                    "{" + tail_str() + "}")
+                                << (step_str().empty()?
                                     step_val == 1? "": ":" + std::to_string(step_val):
-                                    ":{" + step_str + "}") << "]";
+                                    ":{" + step_str() + "}") << "]";
                              return ss.str();
                             }
         std::string         ofst() const {                      // only for COUTABLE
                              if(type == WsType::Range_walk and offset_val != LONG_MIN)
                               return std::to_string(offset_val);
                              std::stringstream ss;
-                             ss << (offset_str.empty()? std::to_string(offset_val):
-                                     "{" + offset_str + "}");
+                             ss << (offset_str().empty()? std::to_string(offset_val):
+                                     "{" + offset_str() + "}");
                              return ss.str();
                             }
-        COUTABLE(WalkStep, search_type(), lexeme, ws_type(), ofst(), range(), label(), json())
+        COUTABLE(WalkStep, search_type(), lexeme(), ws_type(), ofst(), range(), label(), json())
     };
 
 
     // Search Cache Key:
-    // - made of jnode pointer and walk step
+    // - made of jnode pointer and interned walk step signature
     struct CacheKey {
         // Search may occur off any JSON node and in any of WalkSteps, hence a unique
         // key would be their combination
-        // WalkStep (ws) needs to be preserved (cannot be referenced) as the original
-        // walk path might not even exist, while the cache could be still alive and actual
-        friend SWAP(CacheKey, jnp, ws)                              // provide ADL swap operator
-
-                            CacheKey(void) = delete;                // DC
-                            CacheKey(const CacheKey &) = default;   // CC
-                            CacheKey(CacheKey && sck) = default;    // MC
-        CacheKey &          operator=(CacheKey sck) noexcept        // CA, MA
-                             { swap(*this, sck); return *this; }
-
-                            CacheKey(const Jnode *jp, const WalkStep & w):// for emplacement
-                             jnp(jp), ws(w) {}
-                            CacheKey(const Jnode *jp, WalkStep && w):
-                             jnp(jp), ws(std::move(w)) {}
-
+        // WalkStep is represented by an id of its signature (see WalkStep::signature()):
+        // the original walk path might not even exist, while the cache could be still
+        // alive and actual; signatures are interned per Json (see cache_key_())
         const Jnode *       jnp;
-        WalkStep            ws;
+        size_t              sig;                                    // interned signature id
 
-        bool                operator<(const CacheKey &r) const      // map comparator
-                             { return jnp != r.jnp? jnp < r.jnp: ws < r.ws; }
+        bool                operator==(const CacheKey &r) const
+                             { return jnp == r.jnp and sig == r.sig; }
+        struct Hash {
+            size_t              operator()(const CacheKey &k) const
+                                 { return std::hash<const Jnode *>{}(k.jnp) * 31 + k.sig; }
+        };
 
         const Jnode *       json_node(void) const { return jnp; }   // only for COUTABLE
-        COUTABLE(CacheKey, json_node(), ws)
-    };                                                          // end of struct WalkStep
+        COUTABLE(CacheKey, json_node(), sig)
+    };
+
+    // SearchCacheSlot:
+    // - value of SearchCache: all found paths for given CacheKey
+    struct SearchCacheSlot {
+        SearchPaths         paths;                              // cached search results
+        std::vector<Jnode::iter_jn>
+                            children;                           // cached subscripts (offsets)
+        bool                complete{false};                    // entire Jnode was searched
+        size_t              bytes{0};                           // estimated footprint
+        size_t              used{0};                            // tick of last use (for LRU)
+    };
 
     static std::map<std::string, std::vector<WalkStep>>
                         compiled_walks_;                        // compiled walks cache
-
-    typedef std::map<CacheKey, std::vector<SearchCacheEntry>>
+    static std::mutex   cwm_;                                   // guards compiled_walks_
+    static std::unordered_map<std::string, std::shared_ptr<const Regex>>
+                        compiled_res_;                          // compiled REs cache
+    static std::mutex   crm_;                                   // guards compiled_res_
+    static ThreadMaster *
+                        stm_;                                   // search pool (see search_pool())
+
+    typedef std::unordered_map<CacheKey, SearchCacheSlot, CacheKey::Hash>
                         SearchCache;
 
+    // SearchIndex:
+    // - document-wide inverted index of labels and atomic values, serves recursive searches
+    struct SearchIndex {
+        // all JSON nodes are laid out in the document (pre-) order, thus a subtree of any
+        // node makes a contiguous range of positions: (node, end); indexed entries hold
+        // positions of nodes in the same order, so that a search off any node becomes
+        // a range query
+        struct Node {
+            Jnode::iter_jn      jit;                            // node itr (root's is unused)
+            size_t              parent;                         // position of the parent
+            size_t              end;                            // past last descendant position
+        };
+
+                            SearchIndex(void) = default;                    // DC
+                            SearchIndex(const SearchIndex &) {}             // CC: index refers
+        SearchIndex &       operator=(const SearchIndex &)                  // to own tree only,
+                             { clear(); return *this; }                     // hence never copied
+
+        bool                is_built(void) const { return not nodes.empty(); }
+        void                clear(void) {
+                             nodes.clear(); pos.clear(); lbl.clear();
+                             val.clear(); valued = false;
+                            }
+        static std::string  vkey(Jnode::Jtype t, const std::string &v)     // value key: type and
+                             { return std::string(1, static_cast<char>(t)) + v; }  // value
+        static std::string  vkey(const Jnode &jn) {
+                             if(jn.is_bool()) return vkey(jn.type(), jn.bul()? STR_TRUE: STR_FALSE);
+                             return vkey(jn.type(), jn.is_null()? "": jn.val());
+                            }
+
+        std::vector<Node>   nodes;                              // all nodes in document order
+        std::unordered_map<const Jnode *, size_t>
+                            pos;                                // positions of iterables
+        std::unordered_map<std::string, std::vector<size_t>>
+                            lbl;                                // label -> positions of nodes
+        std::unordered_map<std::string, std::vector<size_t>>
+                            val;                                // value key -> positions of nodes
+        bool                valued{false};                      // val is built (lazily too)
+    };
+
     typedef std::map<unsigned short, SortCacheEntry>
                         SortCache;
 
@@ -2694,7 +3094,8 @@ class Json {
                                 lwsi_ < ws_.size() and
                                 not ws_[lwsi_].is_locked() and
                                 ws_[lwsi_].jsearch == Jsearch::key_of_json and
-                                ((x == Json::NonEmptyKoj) ^ ws_[lwsi_].stripped.front().empty()); }
+                                ((x == Json::NonEmptyKoj) ^
+                                 ws_[lwsi_].stripped().front().empty()); }
         signed_size_t       counter(size_t position) const {
                              // returns iterable lexeme's current offset/ounter in the position
                              if(position >= ws_.size())
@@ -2719,7 +3120,7 @@ class Json {
                              // returns reference to the lexeme (non-stripped)
                              if(position >= ws_.size())
                               throw json().EXP(Jnode::ThrowReason::walk_bad_position);
-                             return ws_[position].lexeme;
+                             return ws_[position].lexeme();
                             }
         Jsearch             type(size_t position) const {
                              // returns Jsearch type of the lexeme (regular_match, etc)
@@ -2727,6 +3128,15 @@ class Json {
                               throw json().EXP(Jnode::ThrowReason::walk_bad_position);
                              return ws_[position].jsearch;
                             }
+        bool                is_ns_updating(size_t position) const {
+                             // checks if walking the lexeme might update the namespace
+                             if(position >= ws_.size())
+                              throw json().EXP(Jnode::ThrowReason::walk_bad_position);
+                             auto & ws = ws_[position];
+                             return ws.is(WalkStep::Ns_saving) or ws.is_regex() or  // $0, $1,..
+                                    ws.jsearch AMONG(Jsearch::zip_namespace, Jsearch::Zip_size,
+                                                     Jsearch::Walk_path);
+                            }
         bool                is_walkable(void)
                              // checks if the walk-path is *iterable*
                              { return next_iterable_ws_(walk_path_().size()) >= 0; }
@@ -2745,7 +3155,8 @@ class Json {
         SuperJnode          sn_{Jnode::Jtype::Neither};         // supernode, type_ holds parent's
 
         static std::string  dummy_lbl_;                         // empty (default) label
-      static unsigned short uuid_;                              // universal uid
+    static std::atomic<unsigned short>
+                            uuid_;                              // universal uid
 
 
      private:
@@ -2793,13 +3204,38 @@ class Json {
                              return offset > children? children:
                                     -offset > children? -children: offset;
                             }
-        void                research_(Jnode *jn, size_t wsi,
-                                      std::vector<Json::SearchCacheEntry> *, CacheKey *);
+        CacheKey            cache_key_(const Jnode *jn, WalkStep &ws) {
+                             // intern ws signature only once per cache generation, unless
+                             // lexeme is resolved from namespace (then it's a per walk one)
+                             if(ws.siggen == json().cst_.gen and
+                                (not ws.is(WalkStep::Ns_resolution) or
+                                 ws.is(WalkStep::Re_constant)))
+                              return CacheKey{jn, ws.sigid};
+                             ws.sigid = json().intern_sig_(ws.signature());
+                             ws.siggen = json().cst_.gen;
+                             return CacheKey{jn, ws.sigid};
+                            }
+        void                research_(Jnode *jn, size_t wsi, SearchCacheSlot *);
         bool                re_search_(Jnode *jn, WalkStep &, const char *lbl,
                                        signed_size_t &instance, signed_size_t cdf, SearchType st,
-                                       std::vector<Json::SearchCacheEntry> *);
+                                       SearchPaths *);
+        bool                re_search_children_(Jnode *jn, Jnode::map_jn::iterator from,
+                                                Jnode::map_jn::iterator to, signed_size_t idx,
+                                                WalkStep &, signed_size_t &instance,
+                                                signed_size_t cdf,
+                                                SearchPaths *);
+        bool                is_search_partitionable_(const Jnode *jn, const WalkStep &,
+                                                     signed_size_t instance, signed_size_t cdf,
+                                                     SearchPaths *) const;
+        bool                re_search_partitioned_(Jnode *jn, WalkStep &, signed_size_t &instance,
+                                                   SearchPaths *);
+        bool                is_search_indexable_(const WalkStep &,
+                                             SearchPaths *) const;
+        bool                re_search_indexed_(Jnode *jn, WalkStep &, signed_size_t &instance,
+                                               signed_size_t cdf,
+                                               SearchPaths *);
         bool                cache_entry_(signed_size_t &instance, signed_size_t cdf,
-                                         std::vector<Json::SearchCacheEntry> *);
+                                         SearchPaths *);
         bool                match_iterable_(Jnode *jn, const char *lbl, WalkStep &);
         bool                atomic_match_(const Jnode *jn, const char *lbl,
                                           WalkStep &ws, map_jne * ns);
@@ -2814,8 +3250,10 @@ class Json {
                                          OriginalSrch reverse = Straight) {
                              // facilitate query_original (reverse = false),
                              // and Query_duplicate (reverse = true) lexemes
-                             return json().sortc_.emplace(ws.wsuid, SortCacheEntry{})
-                                           .first->VALUE.sortset.emplace(&jn).second xor reverse;
+                             auto & sce = json().sortc_.emplace(ws.wsuid, SortCacheEntry{})
+                                                       .first->VALUE;
+                             sce.used = json().cst_.tick;
+                             return sce.sortset.emplace(&jn).second xor reverse;
                             }
         size_t              gsort_matches_(const Jnode * jn, WalkStep &ws, size_t offset = -1);
         void                purge_ns_(const std::string & pfx);
@@ -2823,10 +3261,10 @@ class Json {
 
         // callbacks interface
         void                lbl_callback_(const char *lbl,
-                                          const std::vector<Json::SearchCacheEntry> * = nullptr);
+                                          const SearchPaths * = nullptr);
         void                wlk_callback_(const Jnode *);
         void                dmx_callback_(const Jnode *, const char *lbl,
-                                          const std::vector<Json::SearchCacheEntry> * = nullptr);
+                                          const SearchPaths * = nullptr);
 
         // facilitate actual walking (i.e. iterations for walks)
         signed_size_t       increment_(signed_size_t wsi);
@@ -2896,14 +3334,69 @@ class Json {
 
     // data structures (cache storage and callbacks)
     // cache:
-    //      key: made of { WalkStep, *Jnode };
-    //      value: vector<SearchCacheEntry: { namespace (map_jn); vector<path_vector> }>;
+    //      key: made of { *Jnode, WalkStep signature id };
+    //      value: SearchCacheSlot: { SearchPaths: { prefix tree of found paths, namespaces },
+    //                                children, complete, bytes, used };
     // - namespace is required to be a part of the cache to support REGEX values only!
-    SearchCache         srchc_;                                 // search lexemes cache itself
-                        // search cache is the array of all path_vector's for given
-                        // search key (combination of jnode and walk step)
+    // - caches refer to nodes of own tree, hence are never copied (nor moved): a copy of Json
+    //   starts with empty caches, in a new generation and with the default limit
+    template<typename T>
+    struct Uncopied_: public T {                                // T container which copies empty
+                            Uncopied_(void) = default;
+                            Uncopied_(const Uncopied_ &): T{} {}
+        Uncopied_ &         operator=(const Uncopied_ &) { T::clear(); return *this; }
+    };
+    struct CacheState_ {                                        // search caches accounting
+                            CacheState_(void) = default;
+                            CacheState_(const CacheState_ &) {}
+        CacheState_ &       operator=(const CacheState_ &) {
+                             gen = ++cgens_; tick = bytes = 0; limit = SRCH_CACHE_MAX;
+                             return *this;
+                            }
+
+        size_t              gen{++cgens_};                      // generation of sigs_
+        size_t              tick{0};                            // cache use ticks (for LRU)
+        size_t              bytes{0};                           // estimated bytes of srchc_
+        size_t              limit{SRCH_CACHE_MAX};              // search caches limit (0: none)
+    };
 
-    SortCache           sortc_;                                 // mappings for g/G lexemes
+    Uncopied_<SearchCache>
+                        srchc_;                                 // search lexemes cache itself
+                        // search cache holds all found paths for given search key
+                        // (combination of jnode and walk step)
+    Uncopied_<std::unordered_map<std::string, size_t>>
+                        sigs_;                                  // interned ws signatures
+    static std::atomic<size_t>
+                        cgens_;                                 // unique across Json instances
+    CacheState_         cst_;                                   // generation, ticks, bytes, limit
+    size_t              intern_sig_(const std::string &sig) {
+                         if(sigs_.size() >= SRCH_SIGS_MAX) reset_cache_();  // e.g.: dynamic
+                         return sigs_.emplace(sig, sigs_.size() + 1).first->VALUE;  // lexemes
+                        }
+    void                reset_cache_(void) {
+                         srchc_.clear(); sortc_.clear(); sigs_.clear();
+                         cst_.bytes = 0; cst_.gen = ++cgens_;   // invalidate interned ids in ws
+                        }
+    void                account_cache_(SearchCacheSlot &slot, const CacheKey &key,
+                                       signed_size_t wsuid = -1);
+    void                trim_cache_(const CacheKey *keep = nullptr, signed_size_t wsuid = -1);
+
+    SearchIndex         srchi_;                                 // label index (see search_index)
+    bool                indexed_{false};                        // index engaged?
+    bool                captured_{true};                        // RE captures saved in ns?
+    SearchIndex &       search_index_(bool values = false) {    // build index lazily
+                         if(not srchi_.is_built()) {
+                          srchi_.nodes.push_back(SearchIndex::Node{Jnode::iter_jn{}, 0, 0});
+                          index_node_(root(), 0);
+                         }
+                         if(values and not srchi_.valued) index_values_();
+                         return srchi_;
+                        }
+    void                index_node_(Jnode &jn, size_t at);
+    void                index_values_(void);
+
+    Uncopied_<SortCache>
+                        sortc_;                                 // mappings for g/G lexemes
     //
     // sortc_:
     //  map: unsigned short wsuid -> SortCacheEntry
@@ -3014,6 +3507,12 @@ std::map<Json::TmpPlacement, char> Json::tp_{
                                             };
 Json::map_jne Json::dummy_ns_;                                  // facilitate default arg
 std::map<std::string, std::vector<Json::WalkStep>> Json::compiled_walks_;   // compiled walks cache
+std::mutex Json::cwm_;
+std::unordered_map<std::string, std::shared_ptr<const Regex>>
+    Json::compiled_res_;                                        // compiled REs cache
+std::mutex Json::crm_;
+std::atomic<size_t> Json::cgens_{0};                            // search cache generations
+ThreadMaster * Json::stm_{nullptr};
 
 STRINGIFY(Json::Jsearch, JS_ENUM)
 STRINGIFY(Json::WalkStep::WsType, WALKSTEPTYPE)
@@ -3501,7 +4000,7 @@ std::string Json::readup_str_(Streamstr::const_iterator & jsp, size_t n) {
 //       root.children().end())
 
 std::string Json::iterator::dummy_lbl_;                         // used to indicate empty label
-unsigned short Json::iterator::uuid_{0};                        // facilitates unique walk-id: wuid
+std::atomic<unsigned short> Json::iterator::uuid_{0};           // facilitates unique walk-id: wuid
 
 
 Json::iterator Json::walk(const std::string & wstr, CacheState action) {
@@ -3538,48 +4037,78 @@ Json::iterator Json::walk(const std::string & wstr, CacheState action) {
 void Json::compile_walk(const std::string & wstr, iterator & it) const {
  #include "dbgflow.hpp"
  // parse walk string and compile all parts for ws_;
- auto wsit = Json::compiled_walks_.find(wstr);
- if(wsit != Json::compiled_walks_.end()) {
-  DBG(0) DOUT() << "found compiled walk for: '" << wstr << "' in cache" << std::endl;
-  it.walk_path_() = wsit->VALUE;
-  return;
+ {
+  ULOCK(Json::cwm_)                                             // Jsons could be walked
+  auto wsit = Json::compiled_walks_.find(wstr);                 // concurrently
+  if(wsit != Json::compiled_walks_.end()) {
+   DBG(0) DOUT() << "found compiled walk for: '" << wstr << "' in cache" << std::endl;
+   it.walk_path_() = wsit->VALUE;
+   return;
+  }
  }
 
  parse_lexemes_(wstr, it);
  parse_fix_subscript_type_(it);                                 // fix textual offsets
+ for(auto &ws: it.walk_path_()) ws.compile();                   // lower into step program
 
  DBG(0) DOUT() << "dump of completed lexemes:" << std::endl;
  for(size_t i = 0; i < it.walk_path_().size(); ++i)
   DBG(0) DOUT() << '[' << i << "]: " << it.walk_path_()[i] << std::endl;
 
- Json::compiled_walks_[wstr] = it.walk_path_();
+ { ULOCK(Json::cwm_) Json::compiled_walks_[wstr] = it.walk_path_(); }
  DBG(0) DOUT() << "cached in compiled walk '" << wstr << "'" << std::endl;
 }
 
 
 
+void Json::index_node_(Jnode &jn, size_t at) {
+ // lay out jn's descendants (jn is at position 'at') into search index in the document order
+ srchi_.pos.emplace(&jn, at);
+ for(auto it = jn.children_().begin(); it != jn.children_().end(); ++it) {
+  size_t child = srchi_.nodes.size();
+  srchi_.nodes.push_back(SearchIndex::Node{it, at, child + 1});
+  if(jn.is_object()) srchi_.lbl[it->KEY].push_back(child);      // only object children labeled
+  if(it->VALUE.is_iterable()) index_node_(it->VALUE, child);
+ }
+ srchi_.nodes[at].end = srchi_.nodes.size();
+}
+
+
+
+void Json::index_values_(void) {
+ // index atomic values of all laid out nodes (root is not searched, hence not indexed)
+ for(size_t p = 1; p < srchi_.nodes.size(); ++p) {
+  const Jnode & jn = srchi_.nodes[p].jit->VALUE;
+  if(jn.is_atomic()) srchi_.val[SearchIndex::vkey(jn)].push_back(p);
+ }
+ srchi_.valued = true;
+}
+
+
+
 std::string Json::unquote_str(const std::string & src) const {
  #include "dbgflow.hpp"
  // unquote JSON source string as per JSON quotation.
  // even though it looks static, it's best to keep it in-class, due to throwing mechanism
- std::stringstream ss;
+ std::string out;
+ out.reserve(src.size());                                       // unquoting never grows the string
 
  auto h2i = [](char c) { return c >= 'a'? c - 'a' + 10: c >= 'A'? c - 'A' + 10: c - CHR_NUL; };
  auto utf8out = [&](size_t cp, short n) {                       // output n utf-8 bytes
-       if(n == 1) { ss << static_cast<char>(cp); return; }      // assert: cp <= 0x7F
+       if(n == 1) { out += static_cast<char>(cp); return; }     // assert: cp <= 0x7F
        short s{5};
        for(auto rs: {18, 12, 6, 0}) {
         if(--s > n) continue;
         size_t m = s == n? ((1 << n) - 1) << (8 - n): 0x80;     // mask for the respective byte
-        ss << static_cast<char>(m | (((m ^ 0xFF) >> 1) & (cp >> rs)));
+        out += static_cast<char>(m | (((m ^ 0xFF) >> 1) & (cp >> rs)));
        }
       };
 
  size_t start=0;
  size_t hs = 0;
 
- for(size_t end = src.find(CHR_QUOT, start);
-            end != std::string::npos;
+ for(size_t end = src.find(CHR_QUOT, start);                    // clean runs between quotations
+            end != std::string::npos;                           // are copied in bulk
             end = src.find(CHR_QUOT, start)) {
   char qc = src[++end];                                         // quoted character
   if(end >= src.size())                                         // i.e. line ending "...\"
@@ -3587,7 +4116,7 @@ std::string Json::unquote_str(const std::string & src) const {
   const char * ptr = strchr(jsn_qtd_, qc);                      // #define JSN_QTD "/\"\\bfnrtu"
   if(ptr == nullptr)                                            // i.e other (non-Json) char quoted
    throw EXP(Jnode::ThrowReason::unexpected_quotation);
-  ss.write(src.data() + start, end - start - 1);
+  out.append(src.data() + start, end - start - 1);
   if(qc == 'u') {                                               // process \u
    size_t cp{0};
    for(int i = 0; i < 4; ++i)                                   // calculate code-point
@@ -3608,14 +4137,14 @@ std::string Json::unquote_str(const std::string & src) const {
   else {
    if(hs != 0)
     throw EXP(Jnode::ThrowReason::invalid_code_point);          // high surrogate w/o low surrogate
-   ss << JSN_TRL[ptr - jsn_qtd_];                               // translate quotation
+   out += JSN_TRL[ptr - jsn_qtd_];                              // translate quotation
   }
   start = ++end;
  }
  if(hs != 0)
   throw EXP(Jnode::ThrowReason::invalid_surrogate_code_pair);   // high surrogate w/o low surrogate
- ss << src.c_str() + start;
- return ss.str();
+ out.append(src.c_str() + start);
+ return out;
 }
 
 
@@ -3624,17 +4153,10 @@ std::string Json::inquote_str(const std::string & src) const {
  #include "dbgflow.hpp"
  // quote quotation marks and back slashes only, as src is expected to be a valid JSON string
  // because of unquote_str(), keeping this one in-class defined, though it's entirely static
- std::stringstream ss;
- size_t start=0;
- for(size_t end{ src.find_first_of("\"\\", start) };
-            end != std::string::npos;
-            end = src.find_first_of("\"\\", start)) {
-  ss.write(src.data() + start, end - start);
-  ss << CHR_QUOT << src[end];
-  start = end + 1;
- }
- ss << src.c_str() + start;
- return ss.str();
+ Jwriter jw;                                                    // string mode writer
+ jw.str().reserve(src.size() + src.size() / 8);
+ jw.inquote(src);
+ return std::move(jw.str());
 }
 
 
@@ -3670,9 +4192,10 @@ void Json::parse_lexemes_(const std::string & wstr, iterator & it) const {
          continue;
   }
   // store a stripped offset lexeme here (after parsing one)
-  ws.back().stripped.push_back(ws.back().lexeme.substr(1, ws.back().lexeme.size() - 2));
+  auto & txt = *ws.back().txt;
+  txt.stripped.push_back(txt.lexeme.substr(1, txt.lexeme.size() - 2));
   if(not req_label.empty()) {                                   // [label]: was extracted
-   ws.back().stripped.push_back( std::move(req_label.front()) );
+   txt.stripped.push_back( std::move(req_label.front()) );
    req_label.clear();
   }
  }
@@ -3718,7 +4241,7 @@ void Json::parse_suffix_(std::string::const_iterator &si,
   if(not req_label.empty())                                     // label already extracted!
    throw EXP(Jnode::ThrowReason::walk_label_seprator_bad_usage);
   if(back_ws.jsearch == Jsearch::regular_match) return;         // it's a quantifier then (<>:...)
-  req_label.push_back( std::move(back_ws.stripped.back()) );    // it's scoped lexeme: [..]:
+  req_label.push_back( std::move(back_ws.txt->stripped.back()) );   // scoped lexeme: [..]:
   it.walk_path_().pop_back();                                   // label belongs to the next lexeme
   ++si;
   return;
@@ -3740,7 +4263,7 @@ void Json::parse_suffix_(std::string::const_iterator &si,
  if(sfx == Jsearch::fail_safe and back_ws.is_non_recursive())   // ><f limits number of loop count
   back_ws.tail_val = WLK_MAXLOOPCNT;                            // to default value
 
- if(back_ws.stripped.front().empty()) {                         // lexeme is empty, e.g.: <>r
+ if(back_ws.stripped().front().empty()) {                       // lexeme is empty, e.g.: <>r
   if(back_ws.is_lexeme_required())
    throw EXP(Jnode::ThrowReason::walk_empty_lexeme);
  }
@@ -3758,13 +4281,13 @@ void Json::parse_user_json_(WalkStep &ws) const {
  // 1. all lexemes in "is_json_capturing_lexeme()", e.g. <ns:user_json>a, <ns:user_json>v, etc
  // 2. lexeme <user_json>j, here user_json might be a template
  // 3. also handle <ns:user_json>k - here user_json might be only a JSON string type
- const char * json_ptr{ ws.stripped.front().c_str() };          // case: ws.jsearch == json_match
+ const char * json_ptr{ ws.stripped().front().c_str() };        // case: ws.jsearch == json_match
  // find a beginning of user-json (i.e. skip 'ns:' part)
  if(ws.jsearch != Jsearch::json_match) {                        // lexeme is namespace (<ns:json>)
-  size_t json_start = ws.stripped.front().find(RNG_SPR);        // lookging for ':'
+  size_t json_start = ws.stripped().front().find(RNG_SPR);      // lookging for ':'
   if(json_start == std::string::npos or json_start == 0) return;// no ':' then there's no user_json
-  json_ptr = &ws.stripped.front().c_str()[json_start + 1];
-  ws.stripped.front().erase(json_start);
+  json_ptr = &ws.stripped().front().c_str()[json_start + 1];
+  ws.txt->stripped.front().erase(json_start);
  }
  // try parsing user_json
  try {
@@ -3788,14 +4311,16 @@ void Json::parse_user_json_(WalkStep &ws) const {
 
 
 
-std::regex::flag_type Json::parse_RE_flags_(std::string & re_str) const {
+std::regex::flag_type Json::parse_RE_flags_(std::string & re_str, Regex::Engine & eng) const {
  #include "dbgflow.hpp"
  // parse optional RE flags from RE expression. Flags are specified as trailing control chars
- // (which are illegal in Re),e.g.: '...\I\O\P>R' and removed from the RE expression
+ // (which are illegal in Re),e.g.: '...\I\O\P>R' and removed from the RE expression;
+ // flag \T forces std::regex (backtracking) engine, otherwise the engine is auto-selected
  std::regex::flag_type re_grammar{std::regex::ECMAScript};      // default regex grammar
  std::regex::flag_type flag{re_grammar};                        // default regex flag
  static const char * flgs[] = {"\\I", "\\N", "\\O", "\\C",                  // flags
-                               "\\E", "\\S", "\\X", "\\A", "\\G", "\\P"};   // grammar selection
+                               "\\E", "\\S", "\\X", "\\A", "\\G", "\\P",    // grammar selection
+                               "\\T"};                                    // engine selection
  #define FLEN (sizeof("\\I") - 1)                               // i.e. FLEN = 3 - 1 = 2
 
  auto set_grammar = [&flag, &re_grammar](std::regex::flag_type new_grm)
@@ -3818,6 +4343,7 @@ std::regex::flag_type Json::parse_RE_flags_(std::string & re_str) const {
      case 'A': set_grammar(std::regex::awk); break;
      case 'G': set_grammar(std::regex::grep); break;
      case 'P': set_grammar(std::regex::egrep); break;
+     case 'T': eng = Regex::Backtracking; break;
     }
     DBG(1) DOUT() << "RE flag: '" << c_flg[1] << "' is set" << std::endl;
    }
@@ -3825,10 +4351,96 @@ std::regex::flag_type Json::parse_RE_flags_(std::string & re_str) const {
 
  return flag;
 }
+
+
+
+std::shared_ptr<const Regex> Json::compile_RE_(const std::string & re_str) const {
+ #include "dbgflow.hpp"
+ // compile RE (with its trailing flags) only once: compiled REs are shared by all walk steps
+ // and iterations in a process-wide cache (keyed by RE string with flags)
+ {
+  ULOCK(Json::crm_)
+  auto found = Json::compiled_res_.find(re_str);
+  if(found != Json::compiled_res_.end()) return found->VALUE;
+ }
+
+ auto restr = re_str;                                           // copy is required here
+ Regex::Engine eng{Regex::Automaton};                            // unless demoted by Regex
+ auto flags = parse_RE_flags_(restr, eng);
+ std::shared_ptr<const Regex> rexp = std::make_shared<const Regex>(restr, flags, eng);
+ DBG(1) DOUT() << "compiled RE: '" << re_str << "', engine: " << rexp->engine() << std::endl;
+
+ ULOCK(Json::crm_)
+ if(Json::compiled_res_.size() >= RE_CACHE_MAX)                 // e.g.: REs interpolated per
+  Json::compiled_res_.clear();                                  // each walked JSON
+ return Json::compiled_res_.emplace(re_str, std::move(rexp)).first->VALUE;
+}
 #undef FLEN
 
 
 
+void Json::account_cache_(SearchCacheSlot &slot, const CacheKey &key, signed_size_t wsuid) {
+ #include "dbgflow.hpp"
+ // re-estimate footprint of a (re)built cache slot and trim caches if needed
+ auto & sp = slot.paths;
+ size_t bytes = sizeof(SearchCache::value_type) + 2 * sizeof(void*) +
+                sp.nodes.capacity() * sizeof(SearchPaths::Node) +
+                sp.tails.capacity() * sizeof(size_t) +
+                slot.children.capacity() * sizeof(Jnode::iter_jn);
+ for(const auto &ens: sp.ns)
+  for(const auto &kv: ens.VALUE)
+   bytes += sizeof(map_jne::value_type) + 4 * sizeof(void*) + kv.KEY.size() +
+            (kv.VALUE.ref().is_atomic()? kv.VALUE.ref().val().size(): 0);
+ cst_.bytes += bytes - slot.bytes;
+ slot.bytes = bytes;
+ trim_cache_(&key, wsuid);
+}
+
+
+
+void Json::trim_cache_(const CacheKey *keep, signed_size_t wsuid) {
+ #include "dbgflow.hpp"
+ // once search caches (srchc_, sortc_) exceed the limit, evict least recently used ones
+ // (down to 3/4 of the limit, so that eviction is not engaged on each next cache build);
+ // caches being used right now (keep, wsuid) are never evicted
+ if(cst_.limit == 0) return;
+ size_t bytes = cst_.bytes;
+ for(auto &sc: sortc_) bytes += sc.VALUE.bytes();
+ if(bytes <= cst_.limit) return;
+
+ typedef std::tuple<size_t, const CacheKey *, signed_size_t> lru_t;    // used, key, wsuid
+ std::vector<lru_t> lru;
+ lru.reserve(srchc_.size() + sortc_.size());
+ for(auto &sc: srchc_)
+  if(keep == nullptr or not (sc.KEY == *keep))
+   lru.emplace_back(sc.VALUE.used, &sc.KEY, -1);
+ for(auto &sc: sortc_)
+  if(sc.KEY != wsuid)
+   lru.emplace_back(sc.VALUE.used, nullptr, sc.KEY);
+ std::sort(lru.begin(), lru.end(),
+           [](const lru_t &l, const lru_t &r) { return std::get<0>(l) < std::get<0>(r); });
+
+ size_t evicted{0};
+ for(auto &e: lru) {
+  if(bytes <= cst_.limit / 4 * 3) break;
+  if(std::get<1>(e) != nullptr) {
+   auto found = srchc_.find(*std::get<1>(e));
+   bytes -= found->VALUE.bytes;
+   cst_.bytes -= found->VALUE.bytes;
+   srchc_.erase(found);
+  }
+  else {
+   auto found = sortc_.find(std::get<2>(e));
+   bytes -= found->VALUE.bytes();
+   sortc_.erase(found);
+  }
+  ++evicted;
+ }
+ DBG(1) DOUT() << "evicted caches: " << evicted << ", remaining bytes: " << bytes << std::endl;
+}
+
+
+
 Json::Jsearch Json::search_suffix_(char sfx) const {
  #include "dbgflow.hpp"
  // Jsearch is defined so that its first letter corresponds to the suffix
@@ -3895,11 +4507,11 @@ void Json::parse_range_(std::string::const_iterator &si, WalkStep &ws, ParseThro
         break;
   case QNT_OPN:                                                 // '{'
         if(subscript) return;                                   // [{ - text subscript
-        ws.head_str = ws.offset_str = parse_namespaced_qnt_(si);// preserve namespace in ws
+        ws.txt->head_str = ws.txt->offset_str = parse_namespaced_qnt_(si);  // preserve NS in ws
         ws.offset_val = LONG_MIN;                               // indicate NS resolution required
         break;
  case RNG_SPR:                                                  // ':'
-        if(ws.is_qnt_relative() and ws.head_str.empty())        // i.e. if >..<l|t:, but not {idx}:
+        if(ws.is_qnt_relative() and ws.head_str().empty())      // i.e. if >..<l|t:, but not {idx}:
          ws.head_val = ws.offset_val = LONG_MIN + 1;            // indicate entire range select [:
         break;
   default:                                                      // must be numeric
@@ -3910,13 +4522,13 @@ void Json::parse_range_(std::string::const_iterator &si, WalkStep &ws, ParseThro
  if(*si == RNG_SPR) {                                           // only ':' can pass here
   ws.type = WalkStep::WsType::Range_walk;
   if(*++si == QNT_OPN)                                          // ":{
-   { if(quantifier) ws.tail_str = parse_namespaced_qnt_(si); }  // preserve namespace in ws
+   { if(quantifier) ws.txt->tail_str = parse_namespaced_qnt_(si); } // preserve NS in ws
   else                                                          // ":... - must be a number
    if(not end_of_qnt(si) and not (*si == RNG_SPR))
     ws.tail_val = parse_index_(si, throwing);
   if(*si == RNG_SPR) {                                          // ':' must be an increment only
    if(*++si == QNT_OPN)                                         // ":{
-    { if(quantifier) ws.step_str = parse_namespaced_qnt_(si); } // preserve namespace in ws
+    { if(quantifier) ws.txt->step_str = parse_namespaced_qnt_(si); }    // preserve NS in ws
    else                                                         // ":... - must be a number
     if(not end_of_qnt(si))
      ws.step_val = parse_index_(si, throwing, SignLogic::Must_be_positive);
@@ -4008,15 +4620,15 @@ void Json::parse_fix_subscript_type_(Json::iterator & it) const {
   DBG(2) DOUT() << "partial: " << ws << std::endl;
 
   if(ws.is_search()) {                                          // it's a search lexeme's walkstep
-   if(ws.stripped.size() == 2)                                  // there's an attached label scope
+   if(ws.stripped().size() == 2)                                // there's an attached label scope
     if(ws.is_lbl_based())                                       // label (l/L/t) search type cannot
      throw EXP(Jnode::ThrowReason::walk_search_label_with_attached_label);  // attached label offset
    continue;                                                    // don't process search lexeme
   }
   // if not search (and/or directives too), it must be a subscript: [..]
-  auto si = ws.stripped.front().cbegin();
+  auto si = ws.stripped().front().cbegin();
   parse_range_(si, ws, ParseThrow::Dont_throw);
-  if(ws.stripped.front().empty() or *si != CHR_NULL) {
+  if(ws.stripped().front().empty() or *si != CHR_NULL) {
    ws.jsearch = Jsearch::text_offset;                            // parsing failed - it's a text
    ws.type = WalkStep::WsType::Static_select;                    // text can only be Static_select
   }
@@ -4102,7 +4714,7 @@ bool Json::iterator::incremented(void) {
 
  for(auto &ws: ws_) {                                           // reset entire walk-path but NS
   if(ws.type == WalkStep::WsType::Range_walk)                   // reload [_:_] or <>_: lexeme
-   ws.offset_val = ws.type == WalkStep::WsType::Range_walk and not ws.head_str.empty()?
+   ws.offset_val = ws.type == WalkStep::WsType::Range_walk and not ws.head_str().empty()?
                     LONG_MIN: ws.head();
   if(ws.type == Json::WalkStep::WsType::Inactive)               // activate inactivated directives
      ws.type = Json::WalkStep::WsType::Directive;
@@ -4286,17 +4898,12 @@ void Json::iterator::walk_step_(size_t wsi, Jnode *jn) {        // wsi: walk-ste
  DBG(json(), 3)
   DOUT(json()) << "walking step: [" << wsi << "], lexeme: " << ws.search_type() << std::endl;
 
- if(ws.type >= Json::WalkStep::WsType::Directive)
-  return process_directive_(wsi, jn);
-
- switch(ws.jsearch) {
-  case Jsearch::numeric_offset:                                 // [123]
-        return walk_numeric_offset_(wsi, jn);
-  case Jsearch::text_offset:                                    // [abc]
-        return walk_text_offset_(wsi, jn);
-  default:
-        return walk_search_(wsi, jn);                           // facilitate all others: <..>/>..<
- }
+ typedef void (iterator::*step_ptr)(size_t wsi, Jnode *jn);
+ static const step_ptr step[] = {&iterator::walk_numeric_offset_,   // [123]
+                                 &iterator::walk_text_offset_,      // [abc]
+                                 &iterator::walk_search_,           // <..>/>..<
+                                 &iterator::process_directive_};    // directives
+ (this->*step[ws.op])(wsi, jn);
 }
 
 
@@ -4315,16 +4922,16 @@ void Json::iterator::process_directive_(size_t wsi, Jnode *jn) {
 
  switch(ws.jsearch) {
   case Jsearch::Zip_size:                                       // facilitate <..>Z
-        json().ns()[ws.stripped.front()] = ws.is_non_recursive()?
+        json().ns()[ws.stripped().front()] = ws.is_non_recursive()?
                                             jn->children():     // >..<Z
                                             ws.head(json()) == 1?  // <..>Z[1]
                                              (jn->is_string()? jn->str().size(): -1.): jn->size();
         break;
   case Jsearch::zip_namespace:                                  // facilitate <..>z
-        json().erase_ns_(ws.stripped.front());
+        json().erase_ns_(ws.stripped().front());
         break;
   case Jsearch::Walk_path: {                                    // facilitate <..>W
-         auto & jp = json().ns()[ws.stripped.front()] = ARY{};
+         auto & jp = json().ns()[ws.stripped().front()] = ARY{};
          build_path_(jp, *this);
         }
         break;
@@ -4341,7 +4948,7 @@ void Json::iterator::process_directive_(size_t wsi, Jnode *jn) {
         return maybe_nsave_(ws, jn);                            // cannot be inactive, hence return
   case Jsearch::Forward_itr:                                    // facilitate F - directive
         if(ws.is_non_recursive() and ws.offset() == LONG_MIN)   // offset is in NS, needs init'ing
-         ws.offset_val = ws.fetch_from_ns(ws.offset_str, json());// LONG_MIN triggers init from NS
+         ws.offset_val = ws.fetch_from_ns(ws.offset_str(), json()); // LONG_MIN: init from NS
         if(ws.is_recursive() and ws.head() > 1)                 // <>Fn, n > 1
          lock_fs_domain_(wsi, ws.head() - 1);
         end_path_();                                            // let process it in walk_()
@@ -4357,7 +4964,7 @@ void Json::iterator::process_directive_(size_t wsi, Jnode *jn) {
         if(not json().is_engaged(CbType::Lexeme_callback)
            or ws.offset(json()) >= SGNS_T(json().uws_callbacks().size()))
          throw json().EXP(Jnode::ThrowReason::walk_callback_not_engaged);
-        if(not json().uws_callbacks()[ws.offset(json())](ws.stripped.front(), *this))
+        if(not json().uws_callbacks()[ws.offset(json())](ws.stripped().front(), *this))
          end_path_();
         return;                                                 // don't inactivate this directive
   default:
@@ -4375,7 +4982,7 @@ void Json::iterator::step_walk_(size_t wsi) {
  // re-walk (from the root) a path preserved in the NS (facilitate <..>S lexeme)
  auto & ws = ws_[wsi];
  // 0. check if ns exists
- auto found_ns = json().ns().find(ws.stripped.front());
+ auto found_ns = json().ns().find(ws.stripped().front());
  if(found_ns == json().ns().end() or found_ns->VALUE.ref().is_neither())    // non-exist. or erased
   throw json().EXP(Jnode::ThrowReason::walk_non_existant_namespace);
  auto & nse = found_ns->VALUE.ref();
@@ -4419,18 +5026,18 @@ void Json::iterator::process_directive_I_(size_t wsi, Jnode *jn) {
  // facilitate <..>In:m directive (optional: n - increment, m - factor)
  // first increment is added then factored, i.e. <a>In:m -> (a + n) * m
  auto & ws = ws_[wsi];
- auto found_ns = json().ns().find(ws.stripped.front());
+ auto found_ns = json().ns().find(ws.stripped().front());
  auto already_nsaved{false};
 
  // create / init namespace (if not yet)
  if(found_ns == json().ns().end() or found_ns->VALUE.ref().is_neither()) {  // non-exist. or erased
   if(found_ns != json().ns().end())                             // if was erased
-   json().clear_ns(ws.stripped.front());                        // then clear erased value
+   json().clear_ns(ws.stripped().front());                      // then clear erased value
   if(ws.user_json.is_neither())                                 // NO user json (<a:user_json>)
-   json().ns().emplace(ws.stripped.front(), 0);                 // init with 0
+   json().ns().emplace(ws.stripped().front(), 0);               // init with 0
   else                                                          // i.e. <a:user_json>
    { maybe_nsave_(ws, jn); already_nsaved = true; }             // i.e. preserve only on init
-  found_ns = json().ns().find(ws.stripped.front());
+  found_ns = json().ns().find(ws.stripped().front());
  }
  else                                                           // ns already exists
   if(not found_ns->VALUE.ref().is_number())
@@ -4486,40 +5093,36 @@ Jnode::iter_jn Json::iterator::build_cache_(Jnode *jn, size_t wsi) {
  // build cache for subscripts: [..]
  auto &ws = ws_[wsi];
  auto & cache_map = json().srchc_;                              // all caches map
- CacheKey skey{jn, ws};                                         // prepare a search key
+ CacheKey skey = cache_key_(jn, ws);                            // prepare a search key
  auto found_cache = cache_map.find(skey);
  bool build_cache = found_cache == cache_map.end() or           // cache does not exist, or
-                    (found_cache->KEY.ws.type != WalkStep::WsType::Cache_complete and // not cached
-                     SIZE_T(ws.offset()) >= found_cache->VALUE.front().pv.size());
+                    (not found_cache->VALUE.complete and        // not cached yet
+                     SIZE_T(ws.offset()) >= found_cache->VALUE.children.size());
 
  if(build_cache) {
   DBG(json(), 1) DOUT(json()) << "building cache for [" << wsi << "] " << skey << std::endl;
-  auto & cache = found_cache == cache_map.end()? cache_map[skey]: found_cache->VALUE;
+  auto & slot = found_cache == cache_map.end()? cache_map[skey]: found_cache->VALUE;
+  auto & cache = slot.children;
   if(cache.empty())
-   { cache.resize(1); cache.front().pv.emplace_back(jn->children_().begin()); }
+   cache.push_back(jn->children_().begin());
 
   size_t size = ws.type == WalkStep::WsType::Static_select?
                  ws.offset(): normalize_(ws.tail(), jn) - 1;
-  for(size_t i = cache.front().pv.size(); i <= size; ++i) {
-   auto it = cache.front().pv.back().jit;
-   cache.front().pv.emplace_back(++it);
-  }
-  if(cache.front().pv.size() == jn->children_().size()) {
-   // indication that cache is complete is stored in the CacheKey:
-   skey.ws.type = WalkStep::WsType::Cache_complete;             // indicate cache completed
-   auto pc = move(cache);                                       // move/preserve the cache
-   json().srchc_.erase(skey);                                   // erase old skey
-   json().srchc_[skey] = move(pc);                              // create new one
-  }
+  for(size_t i = cache.size(); i <= size; ++i)
+   cache.push_back(std::next(cache.back()));
+  if(cache.size() == jn->children_().size())
+   slot.complete = true;                                        // indicate cache completed
+  json().account_cache_(slot, skey);                            // may evict other caches
 
   found_cache = cache_map.find(skey);
   DBG(json(), 1)
-   DOUT(json()) << "built cache size: " << found_cache->VALUE.front().pv.size()
-                << ", cache status: " << STRENM(WalkStep::WsType, found_cache->KEY.ws.type)
+   DOUT(json()) << "built cache size: " << found_cache->VALUE.children.size()
+                << ", cache status: " << (found_cache->VALUE.complete? "complete": "partial")
                 << std::endl;
  }
 
- return found_cache->VALUE.front().pv[ws.offset()].jit;
+ found_cache->VALUE.used = ++json().cst_.tick;
+ return found_cache->VALUE.children[ws.offset()];
 }
 
 
@@ -4528,7 +5131,7 @@ void Json::iterator::walk_text_offset_(size_t wsi, Jnode *jn) {
  #include "dbgflow.hpp"
  // walk a text offset, e.g.: [label]
  auto &ws = ws_[wsi];
- auto it = jn->children_().find(ws.stripped.front());           // see if label exist
+ auto it = jn->children_().find(ws.stripped().front());         // see if label exist
  if(it == jn->children_().end())
   end_path_();
  else
@@ -4544,7 +5147,7 @@ void Json::iterator::walk_text_offset_(size_t wsi, Jnode *jn) {
 //   o if search_key exists, check if instance ('i') < cache's size:
 //     - if true: (entry instance was already cached) return cached path
 //     - if false (entry instance outside of cache), then check if cache has been completed?
-//       - if type == Cache_complete - return global end (there's no such instance for sure)
+//       - if cache is complete - return global end (there's no such instance for sure)
 //       - otherwise re-search up till the offset/tail index (for static/range respectively)
 // - Caching eligibility:
 //   o non-eligible:
@@ -4557,11 +5160,11 @@ void Json::iterator::walk_search_(size_t wsi, Jnode *jn) {
  // check range (if offset beyond the tail) and do cache-less search, then engaged cached search
  auto & ws = ws_[wsi];
  if(ws.offset() == LONG_MIN)                                    // offset is in NS, needs reloading
-  ws.offset_val = ws.fetch_from_ns(ws.offset_str, json());      // LONG_MIN triggers init from NS
+  ws.offset_val = ws.fetch_from_ns(ws.offset_str(), json());    // LONG_MIN triggers init from NS
 
  size_t offset = ws.offset(json());
  size_t tail = ws.tail(json());
- if(ws.is_qnt_relative()) {                                     // offset & tail must be signed
+ if(ws.is(WalkStep::Qnt_relative)) {                            // offset & tail must be signed
   if(re_normalize_(ws.offset(json()), jn) >= re_normalize_(ws.tail(json()), jn))
    return end_path_();
  }
@@ -4570,11 +5173,11 @@ void Json::iterator::walk_search_(size_t wsi, Jnode *jn) {
    return end_path_();                                          // return |nothing found|
 
  // engage cache-less search:
- if(ws.is_cacheless())
-  return research_(jn, wsi, nullptr, nullptr);                  // vpv=null: cache-less search
+ if(ws.is(WalkStep::Cacheless))
+  return research_(jn, wsi, nullptr);                           // no slot: cache-less search
 
  bool set_neither{false};                                       // set walk's user_json to Neither?
- if(ws.require_ns_resolution())
+ if(ws.is(WalkStep::Ns_resolution))
   set_neither = ws.resolve_ns(*this);                           // only some would require this
 
  // continue with cached walk search
@@ -4590,64 +5193,69 @@ void Json::iterator::walk_search_cached_(size_t wsi, Jnode *jn, size_t offset) {
  #include "dbgflow.hpp"
  // engage search with caching (factored walk_search_):
  auto &ws = ws_[wsi];
- if(ws.jsearch == Jsearch::query_original or ws.jsearch == Jsearch::Query_duplicate)
+ if(ws.is(WalkStep::Query))
   json().sortc_.erase(ws.wsuid);
   // sort cache has to be erased in each (re)walk for original/dup queries to ensure
   // a local significance of a search
 
  auto & cache_map = json().srchc_;                              // all caches map
- CacheKey skey(jn, std::move(ws));                              // prepare a search key
+ CacheKey skey = cache_key_(jn, ws);                            // prepare a search key
  auto found_cache = cache_map.find(skey);
+ if(found_cache != cache_map.end() and ws.is(WalkStep::Sorting) and
+    json().sortc_.count(ws.wsuid) == 0) {                       // sort mapping was evicted:
+  json().cst_.bytes -= found_cache->VALUE.bytes;                // rebuild the search cache too
+  cache_map.erase(found_cache);
+  found_cache = cache_map.end();
+ }
  bool build_cache = found_cache == cache_map.end() or           // cache does not exist, or
-                    (found_cache->KEY.ws.type != WalkStep::Cache_complete and   // not cached yet
-                     offset >= found_cache->VALUE.size());      // or offset is past cached range
+                    (not found_cache->VALUE.complete and        // not cached yet
+                     offset >= found_cache->VALUE.paths.size());    // or offset is past cache
  if(build_cache) {
-  ws = skey.ws;                                                 // skey.ws will be modified
   DBG(json(), 1) DOUT(json()) << "building cache for [" << wsi << "] " << skey << std::endl;
-  auto & cache = found_cache == cache_map.end()? cache_map[skey]: found_cache->VALUE;
-  research_(jn, wsi, &cache, &skey);                            // build cache
+  auto & slot = found_cache == cache_map.end()? cache_map[skey]: found_cache->VALUE;
+  research_(jn, wsi, &slot);                                    // build cache
+  json().account_cache_(slot, skey, ws.wsuid);                  // may evict other caches
   found_cache = cache_map.find(skey);
   DBG(json(), 1)
-   DOUT(json()) << "built cache size: " << found_cache->VALUE.size() << ", cache status: "
-                << STRENM(WalkStep::WsType, found_cache->KEY.ws.type) << std::endl;
+   DOUT(json()) << "built cache size: " << found_cache->VALUE.paths.size()
+                << ", cache status: " << (found_cache->VALUE.complete? "complete": "partial")
+                << std::endl;
  }
- else                                                           // cache was already built
-  ws = std::move(skey.ws);                                      // reinstate ws (after use in skey)
+ found_cache->VALUE.used = ++json().cst_.tick;
+ const auto & cache = found_cache->VALUE.paths;
 
  // find cached entry (if one exist in the cache):
- if(offset >= found_cache->VALUE.size()) {                      // offset outside of cache:
+ if(offset >= cache.size()) {                                   // offset outside of cache:
   DBG(json(), 1) DOUT(json()) << "no cached instance found"<< std::endl;
   return end_path_();                                           // return global end()
  }
 
  DBG(json(), 1) DOUT(json()) << "found cached idx " << offset << std::endl;
- if(ws.jsearch  == Jsearch::go_ascending or ws.jsearch == Jsearch::Go_descending) {
-  offset = gsort_matches_(found_cache->VALUE[offset].pv.empty()?
-                          jn: found_cache->VALUE[offset].pv.back().jnp, ws, offset);
+ if(ws.is(WalkStep::Sorting)) {
+  offset = gsort_matches_(cache.jnp(offset)? cache.jnp(offset): jn, ws, offset);
   DBG(json(), 1) DOUT(json()) << "remapped cached idx " << offset << std::endl;
  }
- for(const auto &path: found_cache->VALUE[offset].pv)           // otherwise augment the path
-  pv_.push_back(path);
- for(const auto &kv: found_cache->VALUE[offset].ns)             // and so do the namespaces
+ cache.path(offset, pv_);                                       // otherwise augment the path
+ for(const auto &kv: cache.namespc(offset))                     // and so do the namespaces
   json().ns()[kv.KEY] = kv.VALUE.ref();
  maybe_nsave_(ws, pv_.empty()? &json().root(): pv_.back().jnp); // save into NS if lexeme is right
 }
 
 
 
-void Json::iterator::research_(Jnode *jn, size_t wsi,
-                               std::vector<Json::SearchCacheEntry> * vpv, CacheKey *skey) {
+void Json::iterator::research_(Jnode *jn, size_t wsi, SearchCacheSlot *slot) {
  #include "dbgflow.hpp"
  // wrapper for re_search_
  auto & ws = ws_[wsi];
+ auto vpv = slot? &slot->paths: nullptr;
 
- signed_size_t i = ws.is_cacheless()?                           // i: instance
+ signed_size_t i = ws.is(WalkStep::Cacheless)?                  // i: instance
                     ws.offset(json()):                          // find only current instance
                     ws.tail(json()) -1;                         // find all up to 'tail' instance
- if(ws.jsearch == Jsearch::go_ascending or ws.jsearch == Jsearch::Go_descending) i = LONG_MAX - 1;
+ if(ws.is(WalkStep::Sorting)) i = LONG_MAX - 1;
  signed_size_t cache_down_from = vpv? i - vpv->size(): i;
 
- if(vpv) vpv->resize(vpv->size() + 1);                          // placeholder for 1st pathvector
+ if(vpv) vpv->reset();                                          // start off an empty path
  DBG(json(), 3)
   DOUT(json()) << "top instance idx: " << (i == LONG_MAX - 1? "all": std::to_string(i))
                << ", cache down from: " << (cache_down_from > LONG_MAX/2? "tail":
@@ -4656,27 +5264,23 @@ void Json::iterator::research_(Jnode *jn, size_t wsi,
                << ", caching? " << (vpv? "yes": "no") << std::endl;
 
  bool found = re_search_(jn, ws, nullptr, i, cache_down_from, SearchType::Non_recursive, vpv);
- if(vpv) vpv->pop_back();                                       // last entry is redundant
+ if(vpv) vpv->reset();                                          // working entry is redundant
  if(found) {
-  if(ws.is_cacheless()) maybe_nsave_(ws, jn);                   // cache-less do not intersect with
+  if(ws.is(WalkStep::Cacheless)) maybe_nsave_(ws, jn);          // cache-less do not intersect with
   return;                                                       // namespace lexemes, so far ...
  }
 
  if(vpv == nullptr)                                             // indicate |nothing found|
   return end_path_();                                           // for cacheless search type
 
- // indication that cache is complete (entire Jnode was searched) is stored in the CacheKey:
- skey->ws.type = WalkStep::Cache_complete;                      // indicate cache completed
- auto nvp = move(*vpv);                                         // move/preserve the cache
- json().srchc_.erase(*skey);                                    // erase old skey
- json().srchc_[*skey] = move(nvp);                              // create new one
+ slot->complete = true;                                         // entire Jnode was searched
 }
 
 
 
 bool Json::iterator::re_search_(Jnode *jn, WalkStep &ws, const char *lbl, signed_size_t &i,
                                 signed_size_t cdf, SearchType pass,
-                                std::vector<Json::SearchCacheEntry> * vpv) {
+                                SearchPaths * vpv) {
  #include "dbgflow.hpp"
  // build cache recursively, return true if match found (i'th instance), otherwise false
  // returning false globally indicates entire json has been searched up
@@ -4685,7 +5289,7 @@ bool Json::iterator::re_search_(Jnode *jn, WalkStep &ws, const char *lbl, signed
  // 3. implementing non-recursive, const type (building cache, vpv != nullptr)
  dmx_callback_(jn, lbl, vpv);
 
- if(pass == SearchType::Recursive or ws.is_recursive()) {       // >..<: allow in recursive pass
+ if(pass == SearchType::Recursive or ws.is(WalkStep::Recursive)) {  // >..<: allow in rec. pass
   if(jn->is_atomic())
    return atomic_match_(jn, lbl, ws, &(vpv? vpv->back().ns: json().ns())) and
           cache_entry_(i, cdf, vpv);
@@ -4694,19 +5298,35 @@ bool Json::iterator::re_search_(Jnode *jn, WalkStep &ws, const char *lbl, signed
    return true;
  }
 
- if(pass == SearchType::Recursive and ws.is_non_recursive())    // >..<: further recursion denied
+ if(pass == SearchType::Recursive and not ws.is(WalkStep::Recursive))  // >..<: no recursion
   return false;
 
- signed_size_t idx = 0;
- for(auto it = jn->children_().begin(); it != jn->children_().end(); ++it) {
+ if(pass == SearchType::Non_recursive and is_search_indexable_(ws, vpv))
+  return re_search_indexed_(jn, ws, i, cdf, vpv);               // take matches off label index
+ if(pass == SearchType::Non_recursive and is_search_partitionable_(jn, ws, i, cdf, vpv))
+  return re_search_partitioned_(jn, ws, i, vpv);                // build cache concurrently
+ return re_search_children_(jn, jn->children_().begin(), jn->children_().end(), 0,
+                            ws, i, cdf, vpv);
+}
+
+
+
+bool Json::iterator::re_search_children_(Jnode *jn, Jnode::map_jn::iterator from,
+                                         Jnode::map_jn::iterator to, signed_size_t idx,
+                                         WalkStep &ws, signed_size_t &i, signed_size_t cdf,
+                                         SearchPaths * vpv) {
+ #include "dbgflow.hpp"
+ // search jn's children in range [from, to), idx is an index of 'from' child
+ for(auto it = from; it != to; ++it) {
   if(vpv) vpv->back().pv.emplace_back(it); else pv_.emplace_back(it);
 
   signed_size_t j = 0;                                          // to be used in lieu of i
   // required so that cache_entry_ returns true in the next call for relative quantifier
   // non-recursive label_match needs to be hoisted out of loop and rewritten - TBD later
-  if(ws.is_lbl_based())
+  if(ws.is(WalkStep::Lbl_based))
    if(label_match_(it, jn, idx, ws, &(vpv? vpv->back().ns: json().ns())) and
-      cache_entry_(ws.is_qnt_relative()? j: i, ws.is_qnt_relative()? j: cdf, vpv))
+      cache_entry_(ws.is(WalkStep::Qnt_relative)? j: i,
+                   ws.is(WalkStep::Qnt_relative)? j: cdf, vpv))
     return true;
 
   if(re_search_(&it->VALUE, ws, jn->is_object()? it->KEY.c_str(): nullptr,
@@ -4722,8 +5342,194 @@ bool Json::iterator::re_search_(Jnode *jn, WalkStep &ws, const char *lbl, signed
 
 
 
+bool Json::iterator::is_search_partitionable_(const Jnode *jn, const WalkStep &ws,
+                                              signed_size_t i, signed_size_t cdf,
+                                              SearchPaths * vpv) const {
+ #include "dbgflow.hpp"
+ // a recursive search could be split over jn's children only when an entire cache is built
+ // from scratch and matching of each node is independent from others (and from namespace)
+ if(vpv == nullptr or not ws.is_recursive() or ws.is_qnt_relative()) return false;
+ if(i != LONG_MAX - 1 or cdf != i) return false;                // not all instances, or not fresh
+ if(stm_ == nullptr or stm_->seats_total() < 2 or stm_->my_worker() != SIZE_T(-1))
+  return false;                                                 // no pool, or called from pool
+ if(jn->children_().size() < SRCH_PRTMIN) return false;         // not worth it
+ if(json().DBG()(0) or json().is_engaged(CbType::Walk_callback) or
+    json().is_engaged(CbType::Label_callback)) return false;
+
+ switch(ws.jsearch) {                                           // lexemes relying on namespace,
+  case Jsearch::search_from_ns:                                 // or on other matches
+  case Jsearch::tag_from_ns:
+  case Jsearch::query_original:
+  case Jsearch::Query_duplicate:
+  case Jsearch::go_ascending:
+  case Jsearch::Go_descending:
+        return false;
+  case Jsearch::json_match:
+        return not ws.user_json.is_neither();                   // template relies on namespace
+  default:
+        return true;
+ }
+}
+
+
+
+bool Json::iterator::re_search_partitioned_(Jnode *jn, WalkStep &ws, signed_size_t &i,
+                                            SearchPaths * vpv) {
+ #include "dbgflow.hpp"
+ // search jn's children in contiguous partitions (one in this thread, others in stm_ pool),
+ // each partition builds own cache, then caches are merged in the (document) order;
+ // entire cache is always built here, thus no instance could be hit (always returns false)
+ struct Partition {
+     Jnode::map_jn::iterator from, to;                          // children range
+     signed_size_t       idx;                                   // index of 'from' child
+     SearchPaths         cache;                                 // partition's own cache
+ };
+
+ size_t children = jn->children_().size(),
+        parts = std::min(children, stm_->seats_total() * 4);    // few per worker to balance load
+ std::vector<Partition> vp(parts);
+ auto it = jn->children_().begin();
+ for(size_t p = 0, idx = 0; p < parts; ++p) {
+  size_t sz = children / parts + (p < children % parts? 1: 0);
+  vp[p].from = it;
+  std::advance(it, sz);
+  vp[p].to = it;
+  vp[p].idx = idx;
+  idx += sz;
+  vp[p].cache.back() = vpv->back();                             // inherit path to jn
+ }
+
+ auto search = [&](Partition &p) {
+  signed_size_t pi = i;                                         // each partition counts its own
+  re_search_children_(jn, p.from, p.to, p.idx, ws, pi, pi, &p.cache);
+ };
+ std::vector<std::future<void>> fut;
+ for(size_t p = 1; p < parts; ++p)
+  fut.push_back(stm_->submit(search, std::ref(vp[p])));
+ std::exception_ptr ep;
+ try { search(vp.front()); }
+ catch(...) { ep = std::current_exception(); }
+ for(auto &f: fut)                                              // all partitions must complete
+  try { f.get(); }                                              // before any rethrow
+  catch(...) { if(not ep) ep = std::current_exception(); }
+ if(ep) std::rethrow_exception(ep);
+
+ for(auto &p: vp) {                                             // merge in the document order
+  i -= p.cache.size();
+  vpv->append(std::move(p.cache));
+ }
+ return false;
+}
+
+
+
+bool Json::iterator::is_search_indexable_(const WalkStep &ws,
+                                          SearchPaths * vpv) const {
+ #include "dbgflow.hpp"
+ // recursive label searches (<..>l, <..>L), recursive searches with attached label ([..]:<..>)
+ // and exact value searches w/o interpolation (<..>, <..>d, <..>b, <..>n) could be served off
+ // the index when building cache (and no callbacks)
+ if(vpv == nullptr or not json().is_search_indexed() or not ws.is(WalkStep::Recursive))
+  return false;
+ if(json().is_engaged(CbType::Walk_callback) or json().is_engaged(CbType::Label_callback))
+  return false;
+ if(ws.jsearch AMONG(Jsearch::label_match, Jsearch::Label_RE_search) or ws.stripped().size() > 1)
+  return true;
+ return ws.jsearch AMONG(Jsearch::regular_match, Jsearch::digital_match,
+                         Jsearch::boolean_match, Jsearch::null_match) and
+        not ws.is(WalkStep::Ns_resolution);
+}
+
+
+
+bool Json::iterator::re_search_indexed_(Jnode *jn, WalkStep &ws, signed_size_t &i,
+                                        signed_size_t cdf,
+                                        SearchPaths * vpv) {
+ #include "dbgflow.hpp"
+ // take candidates off the label/value index within jn's subtree (i.e. in the document order,
+ // the same as re_search_children_ would visit them) and match those only; return value
+ // semantic is the same as of re_search_
+ bool by_value = ws.is_val_based() and ws.stripped().size() == 1; // exact value search
+ auto & si = json().search_index_(by_value);
+ auto found = si.pos.find(jn);
+ if(found == si.pos.end())                                      // jn is not indexed (atomic)
+  return re_search_children_(jn, jn->children_().begin(), jn->children_().end(), 0,
+                             ws, i, cdf, vpv);
+ size_t from = found->VALUE, to = si.nodes[from].end;
+
+ std::vector<std::pair<size_t, const map_jne *>> hits;          // positions and their ns
+ auto collect = [&](const std::vector<size_t> &vp, const map_jne *ns) {
+                 for(auto it = std::upper_bound(vp.begin(), vp.end(), from);
+                     it != vp.end() and *it < to; ++it)
+                  hits.emplace_back(*it, ns);
+                };
+ std::deque<map_jne> lns;                                       // <..>L: ns of matched labels
+ if(ws.jsearch == Jsearch::Label_RE_search) {                   // match each distinct label once
+  for(const auto &lbl: si.lbl) {
+   lns.emplace_back();
+   if(regex_match_(lbl.KEY, ws, &lns.back())) collect(lbl.VALUE, &lns.back());
+   else lns.pop_back();
+  }
+  std::sort(hits.begin(), hits.end());                          // restore the document order
+ }
+ else
+  if(by_value) {                                                // keys of matching values
+   std::vector<std::string> keys;
+   const auto & lxm = ws.stripped().front();
+   switch(ws.jsearch) {
+    case Jsearch::regular_match: keys.push_back(SearchIndex::vkey(Jnode::Jtype::String, lxm));
+                                 break;
+    case Jsearch::digital_match: keys.push_back(SearchIndex::vkey(Jnode::Jtype::Number, lxm));
+                                 break;
+    case Jsearch::null_match:    keys.push_back(SearchIndex::vkey(Jnode::Jtype::Null, ""));
+                                 break;
+    default:                                                    // boolean_match: <true|false>b,
+         if(lxm != STR_FALSE)                                   // any other lexeme matches both
+          keys.push_back(SearchIndex::vkey(Jnode::Jtype::Bool, STR_TRUE));
+         if(lxm != STR_TRUE)
+          keys.push_back(SearchIndex::vkey(Jnode::Jtype::Bool, STR_FALSE));
+   }
+   for(const auto &key: keys) {
+    auto found_val = si.val.find(key);
+    if(found_val != si.val.end()) collect(found_val->VALUE, nullptr);
+   }
+   if(keys.size() > 1) std::sort(hits.begin(), hits.end());    // restore the document order
+  }
+  else {
+   auto found_lbl = si.lbl.find(ws.jsearch == Jsearch::label_match?
+                                ws.stripped().front(): ws.stripped().back());
+   if(found_lbl != si.lbl.end()) collect(found_lbl->VALUE, nullptr);
+  }
+ DBG(json(), 3) DOUT(json()) << "indexed candidates: " << hits.size() << std::endl;
+
+ size_t base = vpv->back().pv.size();                           // path to jn
+ std::vector<size_t> up;
+ for(const auto &hit: hits) {
+  up.clear();
+  for(size_t p = hit.first; p != from; p = si.nodes[p].parent) up.push_back(p);
+  for(auto p = up.rbegin(); p != up.rend(); ++p)                // augment path from jn to the hit
+   vpv->back().pv.emplace_back(si.nodes[*p].jit);
+
+  auto & node = si.nodes[hit.first].jit;
+  bool matched{true};                                           // label/value matched already
+  if(hit.second) vpv->back().ns = *hit.second;                  // <..>L
+  if(ws.is_val_based() and not by_value)                        // attached label: match value
+   matched = node->VALUE.is_atomic()?
+              atomic_match_(&node->VALUE, node->KEY.c_str(), ws, &vpv->back().ns):
+              match_iterable_(&node->VALUE, node->KEY.c_str(), ws);
+  if(matched and cache_entry_(i, cdf, vpv))
+   return true;
+
+  vpv->back().pv.resize(base);
+  vpv->back().ns.clear();
+ }
+ return false;
+}
+
+
+
 bool Json::iterator::cache_entry_(signed_size_t &i, signed_size_t cdf,
-                                  std::vector<Json::SearchCacheEntry> * vpv) {
+                                  SearchPaths * vpv) {
  #include "dbgflow.hpp"
  // cache-in entry if cache pointer was given (if vpv != nullptr)
  // if "to idx" (i) above "cache_from" -
@@ -4731,8 +5537,7 @@ bool Json::iterator::cache_entry_(signed_size_t &i, signed_size_t cdf,
  if(--i >= cdf) return false;                                   // index above "cache from"
 
  if(vpv != nullptr) {                                           // build cache then
-  vpv->push_back(vpv->back());                                  // cache-in (built cache actually)
-  vpv->back().ns.clear();                                       // this is required aft REGEX match
+  vpv->cache_in();                                              // cache-in (built cache actually)
  }
  return i < 0;
 }
@@ -4743,12 +5548,12 @@ bool Json::iterator::match_iterable_(Jnode *jn, const char *lbl, WalkStep &ws) {
  #include "dbgflow.hpp"
  // match any iterable suffixes and attached label (if any)
  // assert(jn->is_iterable())
- if(ws.stripped.size() > 1)                                     // there's an attached search label
-  if(lbl == nullptr or ws.stripped.back() != lbl )              // there's no label
+ if(ws.stripped().size() > 1)                                   // there's an attached search label
+  if(lbl == nullptr or ws.stripped().back() != lbl )            // there's no label
    return false;                                                // label does not match
 
  if(ws.jsearch == Jsearch::search_from_ns) {                    // facilitating <..>s
-  const auto found = json().ns().find(ws.stripped.front());     // see if value was preserved
+  const auto found = json().ns().find(ws.stripped().front());   // see if value was preserved
   if(found == json().ns().end() or found->VALUE.ref().is_neither())
    throw json().EXP(Jnode::ThrowReason::walk_non_existant_namespace);
   return *jn == found->VALUE.ref();
@@ -4779,8 +5584,8 @@ bool Json::iterator::atomic_match_(const Jnode *jn,
                                    const char *lbl, WalkStep &ws, map_jne * nsp) {
  #include "dbgflow.hpp"
  // see if string/number/bool/null value matches
- if(ws.stripped.size() > 1)                                     // label attached: try matching
-  if(lbl == nullptr or ws.stripped.back() != lbl) return false; // no label, or not matching
+ if(ws.stripped().size() > 1)                                   // label attached: try matching
+  if(lbl == nullptr or ws.stripped().back() != lbl) return false; // no label, or not matching
 
  auto user_json_ptr = &ws.user_json;                            // set user_json from walkstep
  switch (ws.jsearch) {
@@ -4832,11 +5637,11 @@ bool Json::iterator::string_match_(const Jnode *jn,
   case Jsearch::Numerical_match:
         return jn->is_number();
   case Jsearch::digital_match:
-        return jn->is_number() and jn->val() == ws.stripped.front();
+        return jn->is_number() and jn->val() == ws.stripped().front();
   case Jsearch::Digital_regex:
         return jn->is_number() and regex_match_(jn->val(), ws, nsp);
   case Jsearch::regular_match:
-        return jn->is_string() and jn->val() == ws.stripped.front();
+        return jn->is_string() and jn->val() == ws.stripped().front();
   case Jsearch::Regex_search:
         return jn->is_string() and regex_match_(jn->val(), ws, nsp);
   default:                                                      // should never reach here
@@ -4851,11 +5656,14 @@ bool Json::iterator::regex_match_(const std::string &val,
  #include "dbgflow.hpp"
  // see if regex matches and if instance matches too - only then update the namespace
 
+ if(not ws.rexp->search(val)) return false;                     // fast engine: no match
+ if(not json().is_re_captured()) return true;                   // nothing to capture
+ std::sregex_iterator it = std::sregex_iterator(val.begin(), val.end(), ws.rexp->std_re());
+ if(it == std::sregex_iterator()) return false;                 // no match: nothing to capture
+
  Jnode am{ARY{}};                                               // all matches - go into '$@' ns
- std::smatch m;
  bool retval{false};
- for(std::sregex_iterator it = std::sregex_iterator(val.begin(), val.end(), ws.rexp);
-     it != std::sregex_iterator(); ++it) {
+ for(; it != std::sregex_iterator(); ++it) {
   for(size_t i = 0; i < it->size() ; ++i) {                     // save matches in the namespace:
    if(it->size() == 1 or i > 0)                                 // groups only or entire match
     am.push_back( std::move(STR{retval? std::move((*it)[i]): (*it)[i]}) );  // but not both
@@ -4867,14 +5675,12 @@ bool Json::iterator::regex_match_(const std::string &val,
   }
   retval = true;
  }
- if(retval) {
-  nsp->emplace( ITRP_ALLM, std::move(am));            // namespace $@ holds all matches
-  DBG(json(), 6)
-   DOUT(json()) << Debug::btw << "preserved in namespace [" << ITRP_ALLM << "]: "
-                 << nsp->at(ITRP_ALLM).ref().to_string(Jnode::Raw, 1) << std::endl;
- }
+ nsp->emplace( ITRP_ALLM, std::move(am));                       // namespace $@ holds all matches
+ DBG(json(), 6)
+  DOUT(json()) << Debug::btw << "preserved in namespace [" << ITRP_ALLM << "]: "
+                << nsp->at(ITRP_ALLM).ref().to_string(Jnode::Raw, 1) << std::endl;
 
- return retval;
+ return true;
 }
 
 
@@ -4885,7 +5691,7 @@ bool Json::iterator::label_match_(Jnode::map_jn::iterator jit, const Jnode *jn,
  // return true if instance i of label (l,t) matches, false otherwise
  map_jne::iterator found;
  if(ws.jsearch == Jsearch::tag_from_ns) {                       // facilitate <..>t / >..<t
-  found = json().ns().find(ws.stripped.front());                // see if value was preserved
+  found = json().ns().find(ws.stripped().front());              // see if value was preserved
   if(found == json().ns().end() or found->VALUE.ref().is_neither())
    throw json().EXP(Jnode::ThrowReason::walk_non_existant_namespace);   // value not found in NS
   if(not (found->VALUE.ref().type() == Jnode::Jtype::String or
@@ -4899,7 +5705,7 @@ bool Json::iterator::label_match_(Jnode::map_jn::iterator jit, const Jnode *jn,
   if(ws.jsearch == Jsearch::tag_from_ns)                        // <..>t
    return jn->is_object()? jit->KEY == found->VALUE.ref().val(): false;
   if(ws.jsearch == Jsearch::label_match)                        // <..>l
-   return jit->KEY == ws.stripped.front();
+   return jit->KEY == ws.stripped().front();
   return regex_match_(jit->KEY, ws, nsp);                       // <..>L
  }
 
@@ -4918,7 +5724,7 @@ bool Json::iterator::label_match_(Jnode::map_jn::iterator jit, const Jnode *jn,
  }
                                                                 // jn is OBJ, all ARY processed
  auto found_lbl = jn->children_().find(ws.jsearch == Jsearch::tag_from_ns?
-                                       found->VALUE.ref().val(): ws.stripped.front());
+                                       found->VALUE.ref().val(): ws.stripped().front());
  if(found_lbl == jn->children_().end()) return false;           // >..<t/l value's not found
  if(idx == 0) {                                                 // first run:
   signed_size_t idx_val = std::distance(jn->children_().begin(), found_lbl);
@@ -4929,7 +5735,7 @@ bool Json::iterator::label_match_(Jnode::map_jn::iterator jit, const Jnode *jn,
  std::advance(jit, -ws_off);
  if(ws.jsearch == Jsearch::tag_from_ns)                         // facilitate >..<t
   return jit->KEY == found->VALUE.ref().val();                  // OBJ: return label match
- return jit->KEY == ws.stripped.front();                        // facilitate >..<l
+ return jit->KEY == ws.stripped().front();                      // facilitate >..<l
 }
 
 
@@ -4940,8 +5746,8 @@ bool Json::iterator::bull_match_(const Jnode *jn, const WalkStep &ws) const {
  switch(ws.jsearch) {
   case Jsearch::boolean_match:
         return jn->is_bool() and
-               (ws.stripped.front() == STR_TRUE? jn->bul():
-                ws.stripped.front() == STR_FALSE? not jn->bul():
+               (ws.stripped().front() == STR_TRUE? jn->bul():
+                ws.stripped().front() == STR_FALSE? not jn->bul():
                 true);
   case Jsearch::null_match:
         return jn->is_null();
@@ -4958,7 +5764,7 @@ bool Json::iterator::json_match_(const Jnode *jn, const WalkStep &ws) {
  if(not ws.user_json.is_neither())                              // i.e. user_json is a valid JSON
   return *jn == ws.user_json;                                   // and not a template
 
- Json jns = Json::interpolate(ws.stripped.front(), *this);      // otherwise, it's a template
+ Json jns = Json::interpolate(ws.stripped().front(), *this);    // otherwise, it's a template
  return jns.is_neither()? false: *jn == jns;
 }
 
@@ -4973,6 +5779,7 @@ size_t Json::iterator::gsort_matches_(const Jnode *jn, WalkStep &ws, size_t offs
  // after cache completion return remapped value for given offset
 
  auto & sce = json().sortc_.emplace(ws.wsuid, SortCacheEntry{}).first->VALUE;  // sort cache entry
+ sce.used = ++json().cst_.tick;
  auto & remap = sce.sortset;
  auto & mapset = sce.offsetmap;
  if(offset == SIZE_T(-1)) {                                     // keep collecting matches
@@ -5017,31 +5824,30 @@ void Json::iterator::purge_ns_(const std::string &pfx) {
 void Json::iterator::maybe_nsave_(WalkStep & ws, const Jnode *jn) {
  #include "dbgflow.hpp"
  // if lexeme is right, save JSON into the namespace, also facilitate ns init <ns:JSON>
- if(ws.jsearch != Jsearch::Increment_num)                       // it allows <uaer_json> saving
-  if(not ws.is_json_capturing_lexeme() or ws.stripped.front().empty())  // don't process empty: <>
-   return;                                                      // or those which are non-capturing
+ if(not ws.is(WalkStep::Ns_saving))                             // non-capturing, or empty: <>
+  return;                                                       // (<..>I allows <uaer_json> saving)
 
  if(ws.jsearch == Jsearch::key_of_json and ws.user_json.is_neither()) { // i.e.: <namespace>k
   if(pv_.empty())
    throw json().EXP(Jnode::ThrowReason::walk_root_has_no_label);
   auto & parent = pv_.size() == 1? json().root(): pv_[pv_.size()-2].jit->VALUE;
-  json().ns()[ws.stripped.front()] = parent.type_ == Jnode::Jtype::Object?
+  json().ns()[ws.stripped().front()] = parent.type_ == Jnode::Jtype::Object?
                                       Jnode{ pv_.back().jit->KEY }:
                                       Jnode{ static_cast<double>(
                                              std::stol(pv_.back().jit->KEY, nullptr, 16)) };
  }
  else                                                           // namespaced
-  json().ns()[ws.stripped.front()] = ws.user_json.is_neither()? *jn: ws.user_json;
+  json().ns()[ws.stripped().front()] = ws.user_json.is_neither()? *jn: ws.user_json;
  DBG(json(), 3)
-  DOUT(json()) << Debug::btw << "preserved in namespace [" << ws.stripped[0] << "]: "
-               << json().ns(ws.stripped[0]).to_string(Jnode::PrettyType::Raw, 1) << std::endl;
+  DOUT(json()) << Debug::btw << "preserved in namespace [" << ws.stripped()[0] << "]: "
+               << json().ns(ws.stripped()[0]).to_string(Jnode::PrettyType::Raw, 1) << std::endl;
  return;
 }
 
 
 
 void Json::iterator::lbl_callback_(const char *label,
-                                   const std::vector<Json::SearchCacheEntry> *vpv) {
+                                   const SearchPaths *vpv) {
  #include "dbgflow.hpp"
  // invoke callback attached to the label (if there's one)
  if(json().lbl_callbacks().count(label) == 0) return;           // label not registered?
@@ -5076,7 +5882,7 @@ void Json::iterator::wlk_callback_(const Jnode *jnp) {
 
 
 void Json::iterator::dmx_callback_(const Jnode *jn, const char *lbl,
-                                   const std::vector<Json::SearchCacheEntry> *vpv) {
+                                   const SearchPaths *vpv) {
  #include "dbgflow.hpp"
  // demux callbacks
  if(json().is_engaged(CbType::Walk_callback)) wlk_callback_(jn);
@@ -5121,7 +5927,7 @@ Json::signed_size_t Json::iterator::increment_(signed_size_t wsi) {
  if(next_wsi < 0) return next_wsi;                              // out of iteratables
 
  // here we need to reload the walkstep's offset with the head's value
- ws.offset_val = ws.type == WalkStep::WsType::Range_walk and not ws.head_str.empty()?
+ ws.offset_val = ws.type == WalkStep::WsType::Range_walk and not ws.head_str().empty()?
                   LONG_MIN: ws.head();
               // LONG_MIN: indicates delayed (until next actual walk) resolution
               // cannot resolve right now, cause NS might have changed by the next walking this ws
@@ -5310,7 +6116,7 @@ Json Json::interpolate(Stringover tmp, Json::iterator &jit,
 
   if(not rj.parsing_failed()) {                                 // if successful interpolation
    if(not (jit.is_koj_last(Json::NonEmptyKoj) and               // and last walked step is not
-           jit.last_walked_().stripped[0] == LBL_KOJ)           //  <:>k - a label interpolation
+           jit.last_walked_().stripped()[0] == LBL_KOJ)         //  <:>k - a label interpolation
       or jit->is_atomic()                                       // request,
       or prty[IntpBit::Interpolate_labels] == true)             // or it's already done - then
     break;                                                      // end interpolation, otherwise -
@@ -5397,6 +6203,7 @@ void Json::generate_auto_tokens_(map_jne &ns, Stringover &tmp, Json::iterator &j
 
  Json w;                                                        // needed for walk()
  w.DBG().severity(NDBG);
+ w.srp_ = &jit->value();                                        // walk jit's node in place
  DBG(jit.json(), 4) {                                           // debug print all found tokens
   DOUT(jit.json()) << "found tokens: ";
   std::string dlm;
@@ -5407,10 +6214,6 @@ void Json::generate_auto_tokens_(map_jne &ns, Stringover &tmp, Json::iterator &j
   DOUT(jit.json()) << std::endl;
  }
 
- auto move2json = [&w, &jit](void) { w.root() = std::move(*jit); return true; };
- auto reinstate = [&w, &jit](bool) { *jit = std::move(w.root()); };
- GUARD(move2json, reinstate);
-
  auto wi = w.walk(sst.empty()? "": "><w:", Json::CacheState::Keep_cache);// walk only if there tkns
  signed_size_t last_idx{0};
  for(const auto &t: sst) {                                      // interpolate found tokens into ns
@@ -5694,6 +6497,8 @@ size_t Json::utf8_adjusted(size_t start, const std::string &jsrc, size_t end) {
 
 
 #undef ARRAY_LMT
+#undef JWR_BLKSZ
+#undef JWR_TABSZ
 #undef WLK_SUCCESS
 #undef SIZE_T
 #undef SGNS_T
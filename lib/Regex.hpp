@@ -0,0 +1,628 @@
+/*
+ * Regex: a RE wrapper with pluggable matching engines, facilitating fast RE searches
+ *
+ *  - std::regex (ECMAScript backtracking) is slow on large inputs, though matching engine
+ *    is only required to tell if there's a match anywhere in the string (captures are
+ *    required only for the strings which do match), hence:
+ *    o Automaton engine: Thompson's NFA simulated via a lazily built DFA (linear time, no
+ *      backtracking), supports a common subset of ECMAScript grammar: literals, escapes
+ *      (\d\D\w\W\s\S\t\n\v\f\r\0\xhh), `.`, classes `[..]`, `^`, `$`, groups `(..)`, `(?:..)`,
+ *      alternation `|`, quantifiers `* + ? {n} {n,} {n,m}` (and their lazy forms); flag icase
+ *    o Backtracking engine: std::regex, a fall back for anything else (backreferences,
+ *      assertions \b \B (?=..) (?!..), other grammars, collate flag, etc)
+ *  - literal substrings required by any match are extracted from RE and checked (memmem)
+ *    before an engine is engaged
+ *  - captures ($0..$n) always should be extracted using std_re() (only for matching strings)
+ *  - Regex is immutable (DFA states are built under a lock), thus could be shared by threads
+ *
+ * SYNOPSIS:
+ *  Regex re("^(\\d+) items?$", std::regex::ECMAScript);    // engine chosen automatically
+ *  if(re.search(str)) {
+ *   std::smatch m;
+ *   std::regex_search(str, m, re.std_re());                // extract captures
+ *   ...
+ *  }
+ *  Regex bt("^(\\d+) items?$", std::regex::ECMAScript, Regex::Backtracking);  // std::regex
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <bitset>
+#include <regex>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#include <cstring>              // memmem
+#include "extensions.hpp"
+
+
+#define RE_DFA_MAX 1024                                         // max DFA states built per RE
+#define RE_NFA_MAX 8192                                         // max NFA size for Automaton
+#define RE_LIT_MAX 4                                            // max prefiltering literals
+#define UCHR(C) static_cast<unsigned char>(C)
+
+
+
+
+class Regex {
+ public:
+
+    #define RE_ENGINE \
+                Automaton,      /* lazy DFA if RE is supported, otherwise std::regex */ \
+                Backtracking    /* std::regex only */
+    ENUM(Engine, RE_ENGINE)
+
+    class ReEngine {
+        // matching engine interface: tells only if there's a match anywhere in the string
+     public:
+        virtual            ~ReEngine(void) = default;
+        virtual bool        search(const char *str, size_t len) const = 0;
+        virtual const char *name(void) const = 0;
+    };
+
+                        Regex(const std::string &re, std::regex::flag_type flags,
+                              Engine eng = Automaton);
+                        Regex(const Regex &) = delete;
+    Regex &             operator=(const Regex &) = delete;
+
+    bool                search(const std::string &str) const {
+                         for(const auto &lit: lits_)            // prefilter with required literals
+                          if(memmem(str.data(), str.size(), lit.data(), lit.size()) == nullptr)
+                           return false;
+                         return eng_->search(str.data(), str.size());
+                        }
+    const std::regex &  std_re(void) const { return re_; }      // use it for captures
+    const char *        engine(void) const { return eng_->name(); }
+
+ private:
+    // parsed RE (the supported subset) - an input for DFA compilation and literals extraction
+    struct Node {
+        enum Type { Set, Cat, Alt, Rep, Bol, Eol };
+                            Node(Type t = Cat): type(t) {}
+        Type                type;
+        std::bitset<256>    set;                                // Set: matching chars
+        std::vector<Node>   sub;                                // Cat, Alt, Rep: sub-nodes
+        int                 min{0}, max{-1};                    // Rep: max = -1 is unbound
+    };
+
+    class Parser;
+    class StdEngine;
+    class DfaEngine;
+
+    static unsigned char
+                        first_char(const std::bitset<256> &set) {
+                         size_t c = 0;
+                         while(c < set.size() - 1 and not set[c]) ++c;
+                         return c;
+                        }
+    void                collect_literals_(const Node &n);
+    void                flush_literal_(std::string &lit);
+
+    std::regex          re_;
+    std::unique_ptr<ReEngine>
+                        eng_;
+    std::vector<std::string>
+                        lits_;                                  // literals required by RE
+};
+
+
+
+
+class Regex::Parser {
+    // recursive descent parser of the supported ECMAScript subset: parse() returns false
+    // for anything unsupported (or erroneous - then std::regex has thrown already)
+ public:
+                        Parser(const std::string &re, bool icase): re_(re), icase_(icase) {}
+
+    bool                parse(Node &n)
+                         { return parse_alt_(n) and i_ == re_.size(); }
+
+ private:
+    bool                parse_alt_(Node &n) {
+                         n = Node{Node::Alt};
+                         do {
+                          n.sub.emplace_back(Node::Cat);
+                          if(not parse_cat_(n.sub.back())) return false;
+                         } while(i_ < re_.size() and re_[i_] == '|' and ++i_);
+                         return true;
+                        }
+    bool                parse_cat_(Node &n) {
+                         while(i_ < re_.size() and re_[i_] != '|' and re_[i_] != ')') {
+                          n.sub.emplace_back();
+                          if(not parse_atom_(n.sub.back()) or not parse_quant_(n.sub.back()))
+                           return false;
+                         }
+                         return true;
+                        }
+    bool                parse_atom_(Node &n);
+    bool                parse_quant_(Node &n);
+    bool                parse_number_(int &x) {
+                         if(not is_digit_()) return false;
+                         for(x = 0; is_digit_(); ++i_)
+                          if((x = x * 10 + re_[i_] - '0') > RE_NFA_MAX) return false;
+                         return true;
+                        }
+    bool                is_digit_(size_t off = 0) const
+                         { return i_ + off < re_.size() and isdigit(UCHR(re_[i_ + off])); }
+    bool                parse_escape_(std::bitset<256> &set, bool &single);
+    bool                parse_class_(std::bitset<256> &set);
+    void                add_char_(std::bitset<256> &set, unsigned char c) const {
+                         set.set(c);
+                         if(icase_ and isalpha(c)) { set.set(tolower(c)); set.set(toupper(c)); }
+                        }
+
+    const std::string & re_;
+    size_t              i_{0};
+    bool                icase_;
+};
+
+
+
+bool Regex::Parser::parse_atom_(Node &n) {
+ // parse a single atom: a char (set), an anchor, or a group
+ char c = re_[i_++];
+ switch(c) {
+  case '(':
+        if(i_ < re_.size() and re_[i_] == '?') {                // only (?:..) is supported
+         if(i_ + 1 >= re_.size() or re_[i_ + 1] != ':') return false;
+         i_ += 2;
+        }
+        if(not parse_alt_(n) or i_ >= re_.size() or re_[i_] != ')') return false;
+        ++i_;
+        return true;
+  case '[':
+        n = Node{Node::Set};
+        return parse_class_(n.set);
+  case '.':
+        n = Node{Node::Set};
+        n.set.set();
+        n.set.reset('\n');
+        n.set.reset('\r');
+        return true;
+  case '^': n = Node{Node::Bol}; return true;
+  case '$': n = Node{Node::Eol}; return true;
+  case '\\': {
+        n = Node{Node::Set};
+        bool single;
+        return parse_escape_(n.set, single);
+       }
+  case '*': case '+': case '?': case '{': case '}': case ']': case ')':
+        return false;                                           // dangling or ambiguous chars
+  default:
+        n = Node{Node::Set};
+        add_char_(n.set, c);
+        return true;
+ }
+}
+
+
+
+bool Regex::Parser::parse_quant_(Node &n) {
+ // parse an optional quantifier of the atom: a quantified atom becomes a child of Rep node
+ if(i_ >= re_.size()) return true;
+ int min, max;
+ switch(re_[i_]) {
+  case '*': min = 0; max = -1; ++i_; break;
+  case '+': min = 1; max = -1; ++i_; break;
+  case '?': min = 0; max = 1; ++i_; break;
+  case '{':
+        ++i_;
+        if(not parse_number_(min)) return false;
+        max = min;
+        if(i_ < re_.size() and re_[i_] == ',') {
+         ++i_;
+         max = -1;
+         if(i_ < re_.size() and re_[i_] != '}' and not parse_number_(max)) return false;
+         if(max >= 0 and max < min) return false;
+        }
+        if(i_ >= re_.size() or re_[i_] != '}') return false;
+        ++i_;
+        break;
+  default:
+        return true;
+ }
+ if(i_ < re_.size() and re_[i_] == '?') ++i_;                   // lazy form: same matching set
+ if(n.type == Node::Bol or n.type == Node::Eol) return false;   // quantified assertion
+ if(i_ < re_.size() and strchr("*+?{", re_[i_]) != nullptr) return false;
+
+ Node rep{Node::Rep};
+ rep.min = min;
+ rep.max = max;
+ rep.sub.push_back(std::move(n));
+ n = std::move(rep);
+ return true;
+}
+
+
+
+bool Regex::Parser::parse_escape_(std::bitset<256> &set, bool &single) {
+ // parse an escape (past '\'): a single char, or a class escape (then single is false)
+ if(i_ >= re_.size()) return false;
+ unsigned char c = re_[i_++];
+ single = false;
+ std::bitset<256> cls;
+ switch(c) {
+  case 'd': case 'D':
+        for(int x = '0'; x <= '9'; ++x) cls.set(x);
+        break;
+  case 'w': case 'W':
+        for(int x = 0; x < 128; ++x) if(isalnum(x) or x == '_') cls.set(x);
+        break;
+  case 's': case 'S':
+        for(const char *x = " \t\n\v\f\r"; *x != '\0'; ++x) cls.set(UCHR(*x));
+        break;
+  case 't': add_char_(set, '\t'); single = true; return true;
+  case 'n': add_char_(set, '\n'); single = true; return true;
+  case 'v': add_char_(set, '\v'); single = true; return true;
+  case 'f': add_char_(set, '\f'); single = true; return true;
+  case 'r': add_char_(set, '\r'); single = true; return true;
+  case '0':
+        if(is_digit_()) return false;                           // octal-like
+        add_char_(set, 0); single = true; return true;
+  case 'x': {
+        if(i_ + 2 > re_.size() or
+           not isxdigit(UCHR(re_[i_])) or not isxdigit(UCHR(re_[i_ + 1]))) return false;
+        add_char_(set, std::stoi(re_.substr(i_, 2), nullptr, 16));
+        i_ += 2;
+        single = true;
+        return true;
+       }
+  default:
+        if(isalnum(c) or c >= 0x80) return false;               // \b, \B, \1, \c, \u, etc
+        add_char_(set, c);                                      // identity escape: \. \\ \[ ...
+        single = true;
+        return true;
+ }
+ if(isupper(c)) cls.flip();
+ set |= cls;
+ return true;
+}
+
+
+
+bool Regex::Parser::parse_class_(std::bitset<256> &set) {
+ // parse a bracket expression (past '['): [abc], [^a-z\d], etc
+ bool negate = i_ < re_.size() and re_[i_] == '^';
+ if(negate) ++i_;
+ if(i_ >= re_.size() or re_[i_] == ']') return false;           // [] and []..] are ambiguous
+
+ while(i_ < re_.size() and re_[i_] != ']') {
+  if(re_[i_] == '[' and i_ + 1 < re_.size() and strchr(":.=", re_[i_ + 1]) != nullptr)
+   return false;                                                // [:alpha:], [.a.], [=a=]
+  std::bitset<256> lo_set;
+  bool single = true;
+  unsigned char lo = re_[i_++];
+  if(lo == '\\') {
+   if(i_ < re_.size() and re_[i_] == 'b') return false;         // [\b] (backspace)
+   if(not parse_escape_(lo_set, single)) return false;
+   if(not single) { set |= lo_set; continue; }                  // class escape: \d, \W, etc
+   lo = first_char(lo_set);
+  }
+  if(i_ + 1 < re_.size() and re_[i_] == '-' and re_[i_ + 1] != ']') {    // range: lo-hi
+   ++i_;
+   unsigned char hi = re_[i_++];
+   if(hi == '\\') {
+    std::bitset<256> hi_set;
+    if(i_ < re_.size() and re_[i_] == 'b') return false;
+    if(not parse_escape_(hi_set, single) or not single) return false;
+    hi = first_char(hi_set);
+   }
+   if(lo > hi or lo >= 0x80 or hi >= 0x80) return false;       // keep ranges plain ASCII
+   for(int x = lo; x <= hi; ++x) add_char_(set, x);
+   continue;
+  }
+  add_char_(set, lo);
+ }
+ if(i_ >= re_.size()) return false;
+ ++i_;                                                          // skip ']'
+ if(negate) set.flip();
+ return true;
+}
+
+
+
+
+class Regex::StdEngine: public Regex::ReEngine {
+ public:
+                        StdEngine(const std::regex &re): re_(re) {}
+    bool                search(const char *str, size_t len) const override
+                         { return std::regex_search(str, str + len, re_); }
+    const char *        name(void) const override { return "backtracking"; }
+
+ private:
+    const std::regex &  re_;
+};
+
+
+
+
+class Regex::DfaEngine: public Regex::ReEngine {
+    // Thompson's NFA is compiled from the parsed RE; DFA states (sets of NFA states) are
+    // built lazily while searching and kept for subsequent searches; searching is
+    // unanchored: NFA start state is merged into each DFA state (except the initial one,
+    // which is built at the beginning of the string - that's where only '^' holds)
+    struct Inst {
+        enum Op { Chr, Split, Jmp, Bol, Eol, Match };
+        Op                  op;
+        int                 x, y;                               // next pcs (Split: both)
+        size_t              set;                                // Chr: index in sets_
+    };
+
+    struct Dstate {
+                            Dstate(std::vector<int> &&s): nfa(std::move(s))
+                             { for(auto &n: next) n.store(-1, std::memory_order_relaxed); }
+        std::vector<int>    nfa;                                // sorted NFA pcs (Chr/Match/Eol)
+        bool                accept{false};                      // match is found
+        bool                accept_end{false};                  // match is found at the end
+        mutable std::atomic<int>
+                            next[256];                          // -1: not built yet
+    };
+
+ public:
+                        DfaEngine(const Node &re) {
+                         built_ = emit_(re) and emit_(Inst::Match);
+                         if(not built_) return;
+                         mark_.resize(prog_.size());
+                         std::vector<int> set;
+                         closure_({0}, true, false, set, mark_, gen_);
+                         add_state_(std::move(set));            // initial state: id 0
+                         closure_({0}, true, true, set, mark_, gen_);
+                         empty_match_ = has_match_(set);        // empty string matching
+                        }
+
+    bool                is_built(void) const { return built_; }
+    const char *        name(void) const override { return "automaton"; }
+
+    bool                search(const char *str, size_t len) const override {
+                         if(len == 0) return empty_match_;
+                         int s = 0;
+                         for(size_t i = 0; i < len; ++i) {
+                          const Dstate & ds = *dstates_[s];
+                          if(ds.accept) return true;
+                          unsigned char c = str[i];
+                          int n = ds.next[c].load(std::memory_order_acquire);
+                          if(n < 0 and (n = transit_(s, c)) < 0)    // DFA is full: simulate
+                           return simulate_(ds.nfa, str + i, len - i);
+                          s = n;
+                         }
+                         return dstates_[s]->accept_end;
+                        }
+
+ private:
+    bool                emit_(Inst::Op op, int x = 0, int y = 0, size_t set = 0) {
+                         prog_.push_back(Inst{op, x, y, set});
+                         return prog_.size() <= RE_NFA_MAX;
+                        }
+    bool                emit_(const Node &n);
+
+    void                closure_(std::vector<int> seeds, bool bol, bool eol,
+                                 std::vector<int> &set, std::vector<unsigned> &mark,
+                                 unsigned &gen) const;
+    bool                has_match_(const std::vector<int> &set) const {
+                         for(auto pc: set) if(prog_[pc].op == Inst::Match) return true;
+                         return false;
+                        }
+    void                step_(const std::vector<int> &set, unsigned char c,
+                              std::vector<int> &seeds) const {
+                         seeds.assign(1, 0);                    // unanchored: always restart
+                         for(auto pc: set)
+                          if(prog_[pc].op == Inst::Chr and sets_[prog_[pc].set][c])
+                           seeds.push_back(pc + 1);
+                        }
+    int                 add_state_(std::vector<int> &&set) const;
+    int                 transit_(int s, unsigned char c) const;
+    bool                simulate_(std::vector<int> set, const char *str, size_t len) const;
+
+    std::vector<Inst>   prog_;                                  // NFA
+    std::vector<std::bitset<256>>
+                        sets_;                                  // char sets of Chr instructions
+    bool                built_{false};
+    bool                empty_match_{false};
+
+    // lazy DFA: states are added under the lock, published via atomic transitions
+    mutable std::mutex  mtx_;
+    mutable std::unique_ptr<Dstate> dstates_[RE_DFA_MAX];
+    mutable size_t      total_{0};                              // states built
+    mutable std::map<std::vector<int>, int>
+                        ids_;                                   // NFA sets -> DFA states
+    mutable std::vector<unsigned>
+                        mark_;                                  // closure's scratch (guarded)
+    mutable unsigned    gen_{0};
+};
+
+
+
+bool Regex::DfaEngine::emit_(const Node &n) {
+ // compile parsed RE node into Thompson's NFA, return false if NFA grows too big
+ switch(n.type) {
+  case Node::Set:
+        sets_.push_back(n.set);
+        return emit_(Inst::Chr, 0, 0, sets_.size() - 1);
+  case Node::Cat:
+        for(const auto &s: n.sub) if(not emit_(s)) return false;
+        return true;
+  case Node::Alt: {
+        std::vector<size_t> jmps;
+        for(size_t i = 0; i < n.sub.size(); ++i) {
+         size_t split = prog_.size();
+         if(i + 1 < n.sub.size() and not emit_(Inst::Split, split + 1)) return false;
+         if(not emit_(n.sub[i])) return false;
+         if(i + 1 == n.sub.size()) break;
+         jmps.push_back(prog_.size());
+         if(not emit_(Inst::Jmp)) return false;
+         prog_[split].y = prog_.size();
+        }
+        for(auto j: jmps) prog_[j].x = prog_.size();
+        return true;
+       }
+  case Node::Rep: {
+        for(int i = 0; i < n.min; ++i)
+         if(not emit_(n.sub.front())) return false;
+        if(n.max < 0) {                                         // unbound: loop
+         size_t split = prog_.size();
+         if(not emit_(Inst::Split, split + 1) or not emit_(n.sub.front()) or
+            not emit_(Inst::Jmp, split)) return false;
+         prog_[split].y = prog_.size();
+         return true;
+        }
+        std::vector<size_t> splits;                             // bound: nested optionals
+        for(int i = n.min; i < n.max; ++i) {
+         splits.push_back(prog_.size());
+         if(not emit_(Inst::Split, prog_.size() + 1) or not emit_(n.sub.front())) return false;
+        }
+        for(auto s: splits) prog_[s].y = prog_.size();
+        return true;
+       }
+  case Node::Bol: return emit_(Inst::Bol);
+  case Node::Eol: return emit_(Inst::Eol);
+ }
+ return false;
+}
+
+
+
+void Regex::DfaEngine::closure_(std::vector<int> seeds, bool bol, bool eol,
+                                std::vector<int> &set, std::vector<unsigned> &mark,
+                                unsigned &gen) const {
+ // follow epsilon transitions from seeds (at the beginning of string if bol, at the end if
+ // eol), collect consuming pcs (Chr), Match and pending (not at the end) Eol into sorted set
+ if(++gen == 0) { std::fill(mark.begin(), mark.end(), 0); gen = 1; }
+ set.clear();
+ while(not seeds.empty()) {
+  int pc = seeds.back();
+  seeds.pop_back();
+  if(mark[pc] == gen) continue;
+  mark[pc] = gen;
+  const auto & in = prog_[pc];
+  switch(in.op) {
+   case Inst::Split: seeds.push_back(in.y); seeds.push_back(in.x); break;
+   case Inst::Jmp: seeds.push_back(in.x); break;
+   case Inst::Bol: if(bol) seeds.push_back(pc + 1); break;
+   case Inst::Eol: if(eol) seeds.push_back(pc + 1); else set.push_back(pc); break;
+   default: set.push_back(pc);
+  }
+ }
+ std::sort(set.begin(), set.end());
+}
+
+
+
+int Regex::DfaEngine::add_state_(std::vector<int> &&set) const {
+ // add a new DFA state (caller holds the lock, if required), return its id
+ std::vector<int> eols, end_set;
+ for(auto pc: set)
+  if(prog_[pc].op == Inst::Eol) eols.push_back(pc + 1);
+ closure_(eols, false, true, end_set, mark_, gen_);
+
+ int id = total_++;
+ dstates_[id].reset(new Dstate{std::move(set)});
+ auto & ds = *dstates_[id];
+ ds.accept = has_match_(ds.nfa);
+ ds.accept_end = ds.accept or has_match_(end_set);
+ ids_.emplace(ds.nfa, id);
+ return id;
+}
+
+
+
+int Regex::DfaEngine::transit_(int s, unsigned char c) const {
+ // build a transition from state s over char c, return -1 if DFA is full
+ ULOCK(mtx_)
+ const auto & ds = *dstates_[s];
+ int n = ds.next[c].load(std::memory_order_relaxed);
+ if(n >= 0) return n;                                           // built by other thread
+
+ std::vector<int> seeds, set;
+ step_(ds.nfa, c, seeds);
+ closure_(std::move(seeds), false, false, set, mark_, gen_);
+ auto found = ids_.find(set);
+ if(found != ids_.end()) n = found->second;
+ else {
+  if(total_ >= RE_DFA_MAX) return -1;
+  n = add_state_(std::move(set));
+ }
+ ds.next[c].store(n, std::memory_order_release);
+ return n;
+}
+
+
+
+bool Regex::DfaEngine::simulate_(std::vector<int> set, const char *str, size_t len) const {
+ // plain NFA simulation (past DFA states limit), set is NFA state before str[0]
+ std::vector<unsigned> mark(prog_.size());
+ unsigned gen{0};
+ std::vector<int> seeds;
+ for(size_t i = 0; i < len; ++i) {
+  if(has_match_(set)) return true;
+  step_(set, str[i], seeds);
+  closure_(std::move(seeds), false, false, set, mark, gen);
+ }
+ if(has_match_(set)) return true;
+ for(auto &pc: set) if(prog_[pc].op == Inst::Eol) seeds.push_back(pc + 1);
+ closure_(std::move(seeds), false, true, set, mark, gen);
+ return has_match_(set);
+}
+
+
+
+
+Regex::Regex(const std::string &re, std::regex::flag_type flags, Engine eng):
+ re_(re, flags) {                                               // throws on a malformed RE
+ // engage Automaton only for ECMAScript grammar w/o collate flag
+ Node parsed;
+ bool plain = (flags & (std::regex::basic | std::regex::extended | std::regex::awk |
+                        std::regex::grep | std::regex::egrep | std::regex::collate)) == 0;
+ bool icase = (flags & std::regex::icase) != 0;
+ if(eng == Automaton and plain and Parser{re, icase}.parse(parsed)) {
+  std::unique_ptr<DfaEngine> dfa{new DfaEngine(parsed)};
+  if(dfa->is_built()) eng_ = std::move(dfa);
+  if(not icase) collect_literals_(parsed);
+  std::sort(lits_.begin(), lits_.end(),                         // most selective first
+            [](const std::string &l, const std::string &r){ return l.size() > r.size(); });
+  if(lits_.size() > RE_LIT_MAX) lits_.resize(RE_LIT_MAX);
+ }
+ if(not eng_) eng_.reset(new StdEngine{re_});
+}
+
+
+
+void Regex::collect_literals_(const Node &n) {
+ // collect literals (runs of single chars) which every match must contain
+ if(n.type == Node::Alt) {                                      // only unambiguous alternation
+  if(n.sub.size() == 1) collect_literals_(n.sub.front());
+  return;
+ }
+ if(n.type == Node::Rep) {                                      // only a required repetition
+  if(n.min > 0) collect_literals_(n.sub.front());
+  return;
+ }
+ if(n.type != Node::Cat) return;
+
+ std::string lit;
+ for(const auto &s: n.sub) {
+  if(s.type == Node::Set and s.set.count() == 1)
+   { lit += static_cast<char>(first_char(s.set)); continue; }
+  flush_literal_(lit);
+  collect_literals_(s);
+ }
+ flush_literal_(lit);
+}
+
+
+
+void Regex::flush_literal_(std::string &lit) {
+ if(not lit.empty() and std::find(lits_.begin(), lits_.end(), lit) == lits_.end())
+  lits_.push_back(lit);
+ lit.clear();
+}
+
+
+#undef RE_DFA_MAX
+#undef RE_NFA_MAX
+#undef RE_LIT_MAX
+#undef RE_ENGINE
+#undef UCHR
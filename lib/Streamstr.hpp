@@ -177,7 +177,7 @@ class Streamstr {
                         fs_;                                    // source file status
     size_t              nf_idx_{0};                             // next fn_ idx being read
     size_t              cnt_{0};                                // offset from beginning of stream
-    bool                drf_{false};                            // defer reading file
+    bool                drf_{false};                            // defer reading file/stream
     Verbosity           vm_{Verbosity::Vocal};                  // verbosity mode
 
  private:
@@ -304,6 +304,7 @@ void Streamstr::ss_init_(const_iterator &it) {
  if(is_buffered_src()) return;                                  // mod: buffered source
 
  if(is_streamed()) {                                            // mod: stream
+  if(drf_) return;                                              // stream read deferred
   std::cin >> std::noskipws;
   buf_.resize(1);
   ++it;
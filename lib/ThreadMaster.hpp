@@ -2,11 +2,15 @@
  * Created by Dmitry Lyssenko.
  *
  * This class let managing threads easily:
- *  - provision (book) thread seats,
- *  - dispatch a new thread in a first available seat, or
- *  - dispatch a new thread in a given seat,
- *  - see if the seat is vacant,
- *  - await until a seat becomes vacant
+ *  - a persistent pool of worker threads runs user tasks:
+ *    o each worker has its own task deque, an idle worker steals tasks from other workers
+ *    o tasks submitted with submit() return std::future with the task's result
+ *  - seats API (on top of the pool) let limiting number of concurrently running tasks:
+ *    o provision (book) task seats,
+ *    o dispatch a new task in a first available seat, or
+ *    o dispatch a new task in a given seat,
+ *    o see if the seat is vacant,
+ *    o await until a seat becomes vacant
  *
  * In addition, class provides following macros:
  * ULOCK(m) - lock mutex guard, until out of scope, e.g.: { ...; ULOCK(m) ... }
@@ -14,22 +18,43 @@
  *
  * SYNOPSIS:
  *  ThreadMaster tm;
+ *  auto f = tm.submit(task0, <list of task 0 arguments>);  // f.get() returns task0's result
  *  tm.run(task1, <list of task 1 arguments>);
  *  tm.run(task2, <list of task 2 arguments>);
  *  // ...
- *  tm.join();
+ *  tm.join();                                              // await all tasks in seats
+ *
+ * Workers may be pinned to cpus: tm.pin({0, 1, 2, 3}); - worker N gets pinned to the cpu
+ * N % 4 in the list (Linux only, elsewhere it's a no-op); being pinned, workers allocate memory
+ * (e.g. parsed JSONs) from their local NUMA nodes (by the first-touch policy)
+ *
+ * Caveat:
+ *  - worker threads are started upon the first dispatched task, the number of workers is then
+ *    fixed (it's a number of seats at the moment), resize() thereafter affects seats only
+ *  - by default (resize(0)) the pool is sized to the number of cpus the process is allowed to
+ *    run on
+ *  - pin() must be called before the first task is dispatched
+ *  - tasks blocking on other tasks' progress should not exceed the number of workers
  */
 
 
 #pragma once
 
 #include <vector>
+#include <deque>
+#include <algorithm>
+#include <memory>
+#include <functional>
+#include <future>
 #include <assert.h>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 #include <utility>              // std::forward
 #include <climits>              // LLONG_MIN
+#ifdef __linux__
+# include <sched.h>             // sched_setaffinity
+#endif
 #include "dbg.hpp"
 #include "extensions.hpp"
 
@@ -55,21 +80,27 @@ class ThreadMaster {
     ENUM(SeatState, SEATSTATE)
     #undef SEATSTATE
 
-                        ThreadMaster(size_t trds = 0) {         // DC
-                         if(trds == 0)
-                          trds = std::thread::hardware_concurrency();
-                         vt_.resize(trds);
-                         vs_.resize(trds, Seat_vacant);
-                         ussm_ = std::unique_lock<std::mutex>(ssm_, std::defer_lock_t());
-                        }
+                        ThreadMaster(size_t trds = 0) { resize(trds); } // DC
                         ThreadMaster(const ThreadMaster &) = delete;
                         ThreadMaster(ThreadMaster &&) = delete;
+                       ~ThreadMaster(void) { join(); stop_workers_(); }
 
     std::mutex &        mtx(void) { return cm_; }               // common mutex
     void                lock(void) { mtx().lock(); }            // lock common mutex
     void                unlock(void) { mtx().unlock(); }        // unlock common mutex
 
-    size_t              thread_count(void) {                    // # of running threads
+    // task API
+    template<typename Fn, typename... Args>
+    auto                submit(Fn &&fn, Args&&... args)
+                         -> std::future<decltype(fn(std::forward<Args>(args)...))>;
+    // queues a user task to the pool and returns future for the task's result
+
+    size_t              workers(void) const { return vwt_.size(); }  // # of running workers
+    size_t              my_worker(void) const                   // to be called within a task
+                         { return tls_().tm == this? tls_().worker: -1; }
+
+    // seats API
+    size_t              thread_count(void) {                    // # of occupied seats
                          size_t cnt = 0;
                          for(auto status: vs_) if(status == Seat_taken) ++cnt;
                          return cnt;
@@ -77,147 +108,181 @@ class ThreadMaster {
     size_t              seat_count(void)                        // # of empty/available seats
                          { return seats_total() - thread_count(); }
     size_t              seats_total(void) const                 // # of total/max slots/threads
-                         { return vt_.size(); }
+                         { return vs_.size(); }
     size_t              size(void) const
                          { return seats_total(); }
     size_t              vacant_seat(void) {                     // find first vacant seat index
-                         // vacant seat is seat where prior thread has finished
+                         // vacant seat is seat where prior task has finished
                          for(size_t seat = 0; seat < seats_total(); ++seat)
                           if(vs_[seat] == Seat_vacant) return seat;
                          return -1;                             // -1: no vacated seats yet
                         }
-    size_t              my_seat(void) {                         // to be called within the thread
-                         for(size_t seat = 0; seat < seats_total(); ++seat)
-                          if(vs_[seat] == Seat_taken)
-                           if(vt_[seat].get_id() == std::this_thread::get_id())
-                            return seat;
-                         return -1;                             // called not from a managed thread
-                        }
+    size_t              my_seat(void) const                     // to be called within the task
+                         { return tls_().tm == this? tls_().seat: -1; }
     void                resize(size_t trds) {
                          ULOCK(mtx())
                          if(trds == 0)
-                          trds = std::thread::hardware_concurrency();
-                         vt_.resize(trds);
+                          trds = available_cpus();
                          vs_.resize(trds, Seat_vacant);
+                         vf_.resize(trds);
                         }
 
+    void                pin(const std::vector<size_t> & cpus)  // pin workers to cpus
+                         { ULOCK(pm_) cpus_ = cpus; }
+    static size_t       available_cpus(void);                   // cpus process may run on
+
     size_t              await_seat(void);                       // until a seat becomes available
-    std::thread &       seat(size_t s) { return vt_.at(s); }    // get thread itself
-    std::thread &       operator[](size_t s) { return seat(s); }
 
     template<typename... Args>
     size_t              run(Args&&... args);
-    // runs a user task in a new thread:
+    // runs a user task in the pool:
     // - allocates first available seat (waits if none available)
     // - and return taken seat number
 
     template<typename... Args>
     size_t              run_seat(size_t seat, Args&&... args);
-    // runs a user task in a new thread in a given seat (seat must be vacant!)
+    // runs a user task in the pool in a given seat (seat must be vacant!)
     // and returns given seat number
 
     void                start_sync(void);                       // "go" signal for start_sync(..)
     template<typename... Args>
     size_t              start_sync(Args&&... args);
-    // starts a new thread to run user task but suspends until start_sync(void) called
+    // runs a user task in a seat but suspends it until start_sync(void) called
 
-    void                join(void)
-                         { for(auto &t: vt_) if(t.joinable()) t.join(); }
+    void                join(void)                              // await tasks in all seats
+                         { for(auto &f: vf_) if(f.valid()) f.wait(); }
 
     DEBUGGABLE()
     EXCEPTIONS(ThrowReason)                                     // see "extensions.hpp"
 
  protected:
-    std::vector<std::thread>
-                        vt_;                                    // vector of threads
  std::vector<SeatState> vs_;                                    // seat taken/vacant: vacant/taken
+    std::vector<std::future<void>>
+                        vf_;                                    // tasks' futures in seats
     std::mutex          cm_;                                    // common mutex (for users)
 
  private:
+    struct Tasks_ {                                             // per worker task deque
+        std::deque<std::function<void(void)>>
+                            dq;
+        std::mutex          mtx;
+    };
+    struct Tls_ {                                               // thread's local records
+        const ThreadMaster *
+                            tm{nullptr};                        // pool the thread belongs to
+        size_t              worker{SIZE_T(-1)};                 // worker index in that pool
+        size_t              seat{SIZE_T(-1)};                   // seat of a running task
+    };
+    static Tls_ &       tls_(void)
+                         { static thread_local Tls_ tls; return tls; }
+
+    std::vector<std::unique_ptr<Tasks_>>
+                        vtq_;                                   // workers' task deques
+    std::vector<std::thread>
+                        vwt_;                                   // workers' threads
+    std::mutex          pm_;                                    // pool mutex (workers parking)
+std::condition_variable pcv_;                                   // workers' parking cv (with pm_)
+    size_t              pending_{0};                            // number of queued tasks
+    size_t              rrw_{0};                                // round-robin worker for queuing
+    std::vector<size_t> cpus_;                                  // cpus to pin workers to
+    bool                stop_{false};                           // workers to finish
+
     std::mutex          rm_;                                    // release mutex (used by class)
-std::condition_variable crm_;                                   // for thread arbitration (with rm_)
+std::condition_variable crm_;                                   // for seats arbitration (with rm_)
 
     std::mutex          ssm_;                                   // start_sync's mutex
-std::unique_lock<std::mutex>
-                        ussm_;                                  // ulock for start_sync's mutex
 std::condition_variable ssc_;                                   // start_sync's condition_variable
-
-    template <class Fn, class... Args>
-    void                run_(Fn &&fn, Args&&... args);          // thread wrapper
+    size_t              ssg_{0};                                // start_sync's "go" generation
+
+    void                enqueue_(std::function<void(void)> &&task);
+    bool                dequeue_(size_t worker, std::function<void(void)> &task);
+    void                start_workers_(void);
+    void                stop_workers_(void);
+    void                worker_(size_t worker);                 // worker's loop
+    void                pin_worker_(size_t worker);             // pin worker to its cpu
+    template<typename... Args>
+    size_t              seat_task_(size_t seat, Args&&... args);
+    void                vacate_(size_t seat);                   // release seat, notify awaiting
     void                availale_seats_(void);                  // debug output only
 
 };
 
 
 
+template<typename Fn, typename... Args>
+auto ThreadMaster::submit(Fn &&fn, Args&&... args)
+ -> std::future<decltype(fn(std::forward<Args>(args)...))> {
+ // wrap user task into a packaged task and queue it
+ typedef decltype(fn(std::forward<Args>(args)...)) Rtype;
+ auto task = std::make_shared<std::packaged_task<Rtype(void)>>
+              (std::bind(std::forward<Fn>(fn), std::forward<Args>(args)...));
+ auto future = task->get_future();
+ enqueue_([task] { (*task)(); });
+ return future;
+}
+
+
+
 template<typename... Args>
 size_t ThreadMaster::run(Args&&... args) {
- // dispatch a new thread
- auto glambda = [&] (auto&&... arg) { return run_(std::forward<decltype(arg)>(arg)...); };
-
+ // dispatch a new task into a first vacant seat
  size_t vs = await_seat();                                      // first vacant seat;
  ULOCK(mtx())
  availale_seats_();                                             // debug output
- DBG(2) DOUT() << "a new thread is taking up a vacant seat[" << vs << "]" << std::endl;
- vt_[vs] = std::thread(glambda, std::forward<decltype(args)>(args)...);
- vs_[vs] = Seat_taken;
- return vs;
+ DBG(2) DOUT() << "a new task is taking up a vacant seat[" << vs << "]" << std::endl;
+ return seat_task_(vs, std::forward<Args>(args)...);
 }
 
 
 
 template<typename... Args>
 size_t ThreadMaster::run_seat(size_t vs, Args&&... args) {
- // dispatch a new thread in a given vacant seat
- auto glambda = [&] (auto&&... arg) { return run_(std::forward<decltype(arg)>(arg)...); };
-
+ // dispatch a new task in a given vacant seat
  ULOCK(mtx())
  if(vs_[vs] == Seat_taken)
   throw EXP(Seat_must_be_vacant);
 
- DBG(2) DOUT() << "a new thread is taking up a vacant seat[" << vs << "]" << std::endl;
- vt_[vs] = std::thread(glambda, std::forward<decltype(args)>(args)...);
- vs_[vs] = Seat_taken;                                          // indicate seat taken
- return vs;
+ DBG(2) DOUT() << "a new task is taking up a vacant seat[" << vs << "]" << std::endl;
+ if(vf_[vs].valid()) vf_[vs].wait();                            // ensure prior task completed
+ return seat_task_(vs, std::forward<Args>(args)...);
 }
 
 
 
 template<typename... Args>
 size_t ThreadMaster::start_sync(Args&&... args) {
- // newly dispatched threads will wait for "go" signal by calling start_sync(void)
- auto glambda = [&] (auto&&... arg) {
-  ssc_.wait(ussm_);                                             // unlock ussm_ and suspend
-  ussm_.mutex()->unlock();
-  return run_(std::forward<decltype(arg)>(arg)...);
+ // dispatched tasks will wait for "go" signal given by calling start_sync(void)
+ size_t gen;
+ { ULOCK(ssm_) gen = ssg_; }                                    // go signal must be past this gen
+ auto go = [this, gen] {
+  std::unique_lock<std::mutex> lck{ssm_};
+  ssc_.wait(lck, [&]{ return ssg_ != gen; });
+  return true;
  };
+ auto glambda = [go] (auto &&fn, auto&&... arg) { go(); fn(std::forward<decltype(arg)>(arg)...); };
 
  size_t vs = await_seat();                                      // next vacant seat;
  ULOCK(mtx())
  availale_seats_();                                             // debug output
- DBG(2) DOUT() << "a new thread is taking up a seat[" << vs << "] and suspends" << std::endl;
- ussm_.lock();                                                  // thread will unlck once suspended
- vt_[vs] = std::thread(glambda, std::forward<decltype(args)>(args)...);
- vs_[vs] = Seat_taken;
- ussm_.mutex()->lock();                                         // wait for the thread to suspend
- ussm_.unlock();
-
- return vs;
+ DBG(2) DOUT() << "a new task is taking up a seat[" << vs << "] and suspends" << std::endl;
+ return seat_task_(vs, glambda, std::forward<Args>(args)...);
 }
 
 
 
 void ThreadMaster::start_sync(void) {
  // this call provides "go" signal for start_sync
- DBG(2) DOUT() << "releasing all suspended threads" << std::endl;
+ DBG(2) DOUT() << "releasing all suspended tasks" << std::endl;
+ { ULOCK(ssm_) ++ssg_; }
  ssc_.notify_all();
 }
 
 
+
 size_t ThreadMaster::await_seat(void) {
  // returns first *available* seat, or waits until one becomes available
  size_t vs;                                                     // vacant seat;
- std::unique_lock<std::mutex> rmulck{rm_};                      // prevent threads from finishing
+ std::unique_lock<std::mutex> rmulck{rm_};                      // prevent tasks from finishing
  while(true) {
   lock();
   vs = vacant_seat();                                           // get first vacant seat
@@ -231,33 +296,163 @@ size_t ThreadMaster::await_seat(void) {
   // 3. upon receiving a notification from `notify_one()` (attempts to) locks the mutex again
  }
 
- if(vt_[vs].joinable())
-  vt_[vs].join();                                               // ensure thread completed
+ if(vf_[vs].valid())
+  vf_[vs].wait();                                               // ensure task completed
  return vs;
 }
 
 
 
-template <class Fn, class... Args>
-void ThreadMaster::run_(Fn &&fn, Args&&... args) {
- fn(std::forward<decltype(args)>(args)...);                     // run user's task
+template<typename... Args>
+size_t ThreadMaster::seat_task_(size_t vs, Args&&... args) {
+ // queue user task into the pool on behalf of the seat (called under mtx())
+ auto seated = [this, vs] (auto &&fn, auto&&... arg) {
+  tls_().seat = vs;
+  try { fn(std::forward<decltype(arg)>(arg)...); }              // run user's task
+  catch(...) {                                                  // seat is vacated regardless,
+   tls_().seat = -1;                                            // exception goes into the future
+   vacate_(vs);
+   throw;
+  }
+  tls_().seat = -1;
+  vacate_(vs);
+ };
+
+ vs_[vs] = Seat_taken;
+ vf_[vs] = submit(seated, std::forward<Args>(args)...);
+ return vs;
+}
+
+
 
- // do clean up after thread finishes
+void ThreadMaster::vacate_(size_t vs) {
+ // do clean up after the seat's task finishes
  ULOCK(rm_)
  ULOCK(mtx())
- for(size_t seat = 0; seat < vt_.size(); ++seat)
-  if(vt_[seat].get_id() == std::this_thread::get_id()) {        // find my seat
-   DBG(2)
-    DOUT() << "thread id " << std::this_thread::get_id()
-           << " is finishing and vacating its seat[" << seat << "]" << std::endl;
-   vs_[seat] = Seat_vacant;                                     // indicate vacated seat
-   return crm_.notify_one();                                    // notify awaitSeat: let to continue
+ DBG(2)
+  DOUT() << "task in thread id " << std::this_thread::get_id()
+         << " is finishing and vacating its seat[" << vs << "]" << std::endl;
+ vs_[vs] = Seat_vacant;                                         // indicate vacated seat
+ crm_.notify_one();                                             // notify awaitSeat: let to continue
+}
+
+
+
+void ThreadMaster::enqueue_(std::function<void(void)> &&task) {
+ // queue the task: a task from a worker goes to its own deque (front, i.e. will be picked
+ // next), tasks from other threads are spread round-robin across the workers (back);
+ // the task is accounted in pending_ before it's published, so pending_ never falls below
+ // the number of queued tasks (which otherwise let parked workers spin)
+ start_workers_();
+ size_t w = my_worker();
+ {
+  ULOCK(pm_)
+  ++pending_;
+  bool own = w != SIZE_T(-1);
+  if(not own) w = rrw_++ % vtq_.size();
+  ULOCK(vtq_[w]->mtx)
+  if(own) vtq_[w]->dq.push_front(std::move(task));
+  else vtq_[w]->dq.push_back(std::move(task));
+ }
+ pcv_.notify_one();
+}
+
+
+
+bool ThreadMaster::dequeue_(size_t w, std::function<void(void)> &task) {
+ // pick a task from the front of own deque, otherwise steal from the back of others' deques,
+ // i.e. from the end opposite to where the owner picks its tasks
+ for(size_t i = 0; i < vtq_.size(); ++i) {
+  auto & tq = *vtq_[(w + i) % vtq_.size()];
+  {
+   ULOCK(tq.mtx)
+   if(tq.dq.empty()) continue;
+   if(i == 0)
+    { task = std::move(tq.dq.front()); tq.dq.pop_front(); }
+   else
+    { task = std::move(tq.dq.back()); tq.dq.pop_back(); }
   }
+  DBG(2) if(i > 0) DOUT() << "worker " << w << " stole a task" << std::endl;
+  ULOCK(pm_)
+  --pending_;
+  return true;
+ }
+ return false;
+}
+
+
+
+void ThreadMaster::start_workers_(void) {
+ // start the pool (once), the number of workers is the number of seats
+ ULOCK(pm_)
+ if(not vwt_.empty()) return;
+
+ size_t trds = std::max(seats_total(), SIZE_T(1));
+ DBG(2) DOUT() << "starting " << trds << " worker(s)" << std::endl;
+ for(size_t w = 0; w < trds; ++w) vtq_.emplace_back(new Tasks_);
+ for(size_t w = 0; w < trds; ++w) vwt_.emplace_back(&ThreadMaster::worker_, this, w);
+}
+
 
- throw EXP(Bug_unreachable_point);
+
+void ThreadMaster::stop_workers_(void) {
+ // let workers complete all queued tasks and finish
+ { ULOCK(pm_) stop_ = true; }
+ pcv_.notify_all();
+ for(auto &t: vwt_) if(t.joinable()) t.join();
+}
+
+
+
+size_t ThreadMaster::available_cpus(void) {
+ // number of cpus the process is allowed to run on (e.g., when restricted by taskset)
+ #ifdef __linux__
+  cpu_set_t set;
+  if(sched_getaffinity(0, sizeof(set), &set) == 0 and CPU_COUNT(&set) > 0)
+   return CPU_COUNT(&set);
+ #endif
+ return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+
+
+void ThreadMaster::pin_worker_(size_t w) {
+ // pin calling worker to a cpu from cpus_ list (round-robin)
+ std::vector<size_t> cpus;
+ { ULOCK(pm_) cpus = cpus_; }
+ if(cpus.empty()) return;
+ #ifdef __linux__
+  if(cpus[w % cpus.size()] >= CPU_SETSIZE) return;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpus[w % cpus.size()], &set);
+  bool ok = sched_setaffinity(0, sizeof(set), &set) == 0;
+  DBG(2) DOUT() << "worker " << w << (ok? " is pinned to cpu ": " failed pinning to cpu ")
+                << cpus[w % cpus.size()] << std::endl;
+ #endif
 }
 
 
+
+void ThreadMaster::worker_(size_t w) {
+ // worker's loop: run tasks while there are any, otherwise park
+ tls_().tm = this;
+ tls_().worker = w;
+ pin_worker_(w);
+
+ std::function<void(void)> task;
+ while(true) {
+  if(dequeue_(w, task))
+   { task(); task = nullptr; continue; }
+
+  std::unique_lock<std::mutex> lck{pm_};
+  pcv_.wait(lck, [&]{ return stop_ or pending_ > 0; });
+  if(stop_ and pending_ == 0) break;
+ }
+}
+
+
+
 void ThreadMaster::availale_seats_(void) {
  // print debug outputs of available/vacant seats now (it's under mtx() already)
  size_t last_output{0}, prior_vacant{0}, pfx{0};